@@ -0,0 +1,150 @@
+// Enemy update benchmark: frame time of EnemyManager against enemy count.
+//
+// Spawns N enemies spread over the largest floor of a map, walks a scripted
+// player in a circle through them and times EnemyManager::update plus the
+// per-frame contact-damage query, with separation steering on and off.
+// No window or GL context is needed.
+//
+// Usage: enemy_bench [map.json] [frames]
+
+#include "engine/map.h"
+#include "engine/log.h"
+#include "enemy/enemy_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace silic2;
+
+namespace {
+
+struct FrameStats {
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    size_t contacts = 0;  // Peak number of enemies touching the player
+};
+
+const Brush* largestFloor(const Map& map) {
+    const Brush* best = nullptr;
+    float bestArea = -1.0f;
+    for (const Brush* brush : map.getFloorBrushes()) {
+        if (brush->vertices.empty()) continue;
+        glm::vec3 lo = brush->vertices[0], hi = brush->vertices[0];
+        for (const auto& v : brush->vertices) {
+            lo = glm::min(lo, v);
+            hi = glm::max(hi, v);
+        }
+        float area = (hi.x - lo.x) * (hi.z - lo.z);
+        if (area > bestArea) {
+            bestArea = area;
+            best = brush;
+        }
+    }
+    return best;
+}
+
+FrameStats runCase(const Map& baseMap, const glm::vec3& floorMin, const glm::vec3& floorMax,
+                   int enemyCount, bool separation, int frames) {
+    // Deterministic spawn layout for every case
+    Map map = baseMap;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> rx(floorMin.x + 0.5f, floorMax.x - 0.5f);
+    std::uniform_real_distribution<float> rz(floorMin.z + 0.5f, floorMax.z - 0.5f);
+    for (int i = 0; i < enemyCount; ++i) {
+        Entity spawn;
+        spawn.type = EntityType::ENEMY_SPAWN;
+        spawn.position = glm::vec3(rx(rng), floorMax.y + 0.1f, rz(rng));
+        map.addEntity(spawn);
+    }
+
+    EnemyManager enemies;
+    enemies.setSeparationEnabled(separation);
+    enemies.spawnFromMap(map);
+
+    const float dt = 1.0f / 60.0f;
+    glm::vec3 center = (floorMin + floorMax) * 0.5f;
+    float radius = 0.25f * std::min(floorMax.x - floorMin.x, floorMax.z - floorMin.z);
+
+    std::vector<double> times;
+    times.reserve(frames);
+    FrameStats stats;
+    const int warmup = 30;
+    for (int f = 0; f < warmup + frames; ++f) {
+        float angle = f * dt * 0.5f;
+        glm::vec3 playerPos(center.x + radius * std::cos(angle), floorMax.y, center.z + radius * std::sin(angle));
+
+        auto t0 = std::chrono::steady_clock::now();
+        enemies.update(dt, playerPos, &map);
+        volatile float dps = enemies.getContactDps(playerPos);
+        (void)dps;
+        auto t1 = std::chrono::steady_clock::now();
+
+        if (f >= warmup) {
+            times.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+            size_t touching = 0;
+            const EnemyPool& pool = enemies.getEnemies();
+            for (uint32_t slot = 0; slot < pool.getSlotCount(); ++slot) {
+                if (pool.isLive(slot) && pool.get(slot).isTouchingPlayer(playerPos)) ++touching;
+            }
+            stats.contacts = std::max(stats.contacts, touching);
+        }
+    }
+
+    double sum = 0.0;
+    for (double t : times) sum += t;
+    std::sort(times.begin(), times.end());
+    stats.meanMs = sum / times.size();
+    stats.p50Ms = times[times.size() / 2];
+    stats.p99Ms = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    stats.maxMs = times.back();
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mapPath = argc > 1 ? argv[1] : "res/maps/complex_base.json";
+    int frames = argc > 2 ? std::max(1, std::atoi(argv[2])) : 300;
+
+    // Keep the report readable: only warnings and errors, which go to stderr
+    Logger::getInstance().setLevel(LogLevel::WARN);
+
+    Map map;
+    if (!map.loadFromFile(mapPath)) {
+        SILIC2_LOG_ERROR("enemy_bench: failed to load map " << mapPath);
+        return 1;
+    }
+
+    const Brush* floor = largestFloor(map);
+    if (!floor) {
+        SILIC2_LOG_ERROR("enemy_bench: map has no floor brushes");
+        return 1;
+    }
+    glm::vec3 floorMin = floor->vertices[0], floorMax = floor->vertices[0];
+    for (const auto& v : floor->vertices) {
+        floorMin = glm::min(floorMin, v);
+        floorMax = glm::max(floorMax, v);
+    }
+
+    std::printf("map: %s, %d frames per case, dt = 1/60 s\n", mapPath.c_str(), frames);
+    std::printf("%8s  %-10s %9s %9s %9s %9s %11s %9s\n",
+                "enemies", "separation", "mean ms", "p50 ms", "p99 ms", "max ms", "us/enemy", "touching");
+
+    const int counts[] = {10, 100, 500, 1000, 2500, 5000, 10000};
+    for (int count : counts) {
+        for (bool separation : {false, true}) {
+            FrameStats s = runCase(map, floorMin, floorMax, count, separation, frames);
+            std::printf("%8d  %-10s %9.3f %9.3f %9.3f %9.3f %11.3f %9zu\n",
+                        count, separation ? "on" : "off", s.meanMs, s.p50Ms, s.p99Ms, s.maxMs,
+                        s.meanMs * 1000.0 / count, s.contacts);
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
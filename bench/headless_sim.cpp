@@ -0,0 +1,410 @@
+// Headless simulation harness: runs the gameplay update without GLFW, a window
+// or a GL context and reports per-subsystem tick costs as JSON.
+//
+// Loads a map, optionally adds extra enemies on its largest floor, then steps
+// Player, Weapon, EnemyManager and GroundParticleSystem at the configured
+// simulation tick rate for N ticks. Nothing is rendered. Input is either
+// scripted (the player walks a loop while turning, toggles sprint, jumps and
+// holds the trigger) or replayed from a recording made with `silic2 --record`.
+// Each tick mirrors App: input, then the game-state update.
+//
+// Usage: headless_sim [map.json] [ticks] [extra enemies] [hitscan] [--workers N] [--trace out.json]
+//        headless_sim --replay file [--workers N] [--trace out.json]
+// --trace writes every tick's profiler zones as a Chrome trace.
+#include "engine/map.h"
+#include "engine/camera.h"
+#include "engine/game_config.h"
+#include "engine/input_recording.h"
+#include "engine/job_system.h"
+#include "engine/log.h"
+#include "engine/profiler.h"
+#include "engine/run_state.h"
+#include "player/player.h"
+#include "player/weapon.h"
+#include "enemy/enemy_manager.h"
+#include "effects/groundparticle.h"
+#include "effects/particle_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace silic2;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum Subsystem { PLAYER, WEAPON, ENEMIES, PARTICLES, TOTAL, SUBSYSTEM_COUNT };
+const char* const SUBSYSTEM_NAMES[SUBSYSTEM_COUNT] = {"player", "weapon", "enemies", "particles", "total"};
+
+double elapsedMs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+const Brush* largestFloor(const Map& map) {
+    const Brush* best = nullptr;
+    float bestArea = -1.0f;
+    for (const Brush* brush : map.getFloorBrushes()) {
+        if (brush->vertices.empty()) continue;
+        glm::vec3 lo = brush->vertices[0], hi = brush->vertices[0];
+        for (const auto& v : brush->vertices) {
+            lo = glm::min(lo, v);
+            hi = glm::max(hi, v);
+        }
+        float area = (hi.x - lo.x) * (hi.z - lo.z);
+        if (area > bestArea) {
+            bestArea = area;
+            best = brush;
+        }
+    }
+    return best;
+}
+
+// Deterministic extra spawns spread over the largest floor
+void addEnemySpawns(Map& map, int count) {
+    const Brush* floor = largestFloor(map);
+    if (!floor || count <= 0) return;
+    glm::vec3 lo = floor->vertices[0], hi = floor->vertices[0];
+    for (const auto& v : floor->vertices) {
+        lo = glm::min(lo, v);
+        hi = glm::max(hi, v);
+    }
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> rx(lo.x + 0.5f, hi.x - 0.5f);
+    std::uniform_real_distribution<float> rz(lo.z + 0.5f, hi.z - 0.5f);
+    for (int i = 0; i < count; ++i) {
+        Entity spawn;
+        spawn.type = EntityType::ENEMY_SPAWN;
+        spawn.position = glm::vec3(rx(rng), hi.y + 0.1f, rz(rng));
+        map.addEntity(spawn);
+    }
+}
+
+// Scripted controls for tick 't': walk a loop while turning, tap sprint and jump
+// now and then, keep the trigger held
+TickInput scriptedInput(int t) {
+    TickInput input;
+    input.player.forward = (t % 240) < 200;
+    input.player.left    = (t % 480) >= 360;
+    input.player.sprint  = (t % 300) == 0;
+    input.player.jump    = (t % 90) == 45;
+    input.player.crouch  = (t % 600) >= 590;
+    input.fire = true;
+    input.look = glm::vec2(20.0f, 0.0f);
+    return input;
+}
+
+// The gameplay half of App: same subsystems, same per-tick order and state machine
+struct HeadlessGame {
+    Map& map;
+    glm::vec3 startPos;
+    Player player;
+    Camera camera;
+    Weapon weapon;  // init() only loads shaders and meshes; update() needs neither
+    EnemyManager enemies;
+    std::unique_ptr<GroundParticleSystem> particles;
+
+    GameState gameState = GameState::PLAYING;
+    float stateTimer = 0.0f;
+    bool escWasPressed = false;
+    bool fireModeWasPressed = false;
+
+    double tickMs[SUBSYSTEM_COUNT] = {};  // Cost of the current tick per subsystem
+
+    TaskGraph tickGraph;
+    float tickGraphDt = 0.0f;
+
+    HeadlessGame(Map& m, const glm::vec3& start)
+        : map(m), startPos(start), player(start), camera(start + glm::vec3(0.0f, 1.6f, 0.0f)) {
+        enemies.spawnFromMap(map);
+        particles = createEnhancedGroundParticleSystem(2000, GroundParticleSystem::GParticleMode::FIRE);
+        particles->initialize(map);
+        particles->setEmissionRate(GameConfig::getInstance().effects.groundParticleEmissionRate);
+        particles->setFireIntensity(GameConfig::getInstance().effects.groundParticleIntensity);
+        if (!GameConfig::getInstance().effects.groundParticleCollision) {
+            particles->setCollision(ParticleCollision::NONE);
+        }
+    }
+
+    void setState(GameState next) {
+        gameState = next;
+        stateTimer = 0.0f;
+    }
+
+    // App::applyInput
+    void applyInput(const TickInput& input, float dt) {
+        auto t0 = Clock::now();
+        if (input.pause && !escWasPressed) {
+            if (gameState == GameState::PLAYING) setState(GameState::PAUSED);
+            else if (gameState == GameState::PAUSED) setState(GameState::PLAYING);
+        }
+        escWasPressed = input.pause;
+        if (gameState != GameState::PLAYING) return;
+
+        if (input.look != glm::vec2(0.0f)) {
+            player.processMouseMovement(&camera, input.look.x, input.look.y);
+        }
+        player.processInput(input.player, &camera, dt);
+        auto t1 = Clock::now();
+
+        if (input.toggleFireMode && !fireModeWasPressed) {
+            bool hitscan = weapon.getFireMode() == Weapon::FireMode::HITSCAN;
+            weapon.setFireMode(hitscan ? Weapon::FireMode::PROJECTILE : Weapon::FireMode::HITSCAN);
+        }
+        fireModeWasPressed = input.toggleFireMode;
+        if (input.fire) weapon.fire(camera);
+        auto t2 = Clock::now();
+
+        tickMs[PLAYER] += elapsedMs(t0, t1);
+        tickMs[WEAPON] += elapsedMs(t1, t2);
+    }
+
+    // App::update
+    void update(float dt) {
+        stateTimer += dt;
+        switch (gameState) {
+            case GameState::PLAYING:
+                updatePlaying(dt);
+                break;
+            case GameState::ROOM_CLEARED:
+                if (stateTimer >= 1.0f) setState(GameState::PLAYING);
+                break;
+            case GameState::PLAYER_DEAD:
+                player.respawn(startPos);
+                camera.setPosition(startPos + glm::vec3(0.0f, 1.6f, 0.0f));
+                enemies.spawnFromMap(map);
+                setState(GameState::PLAYING);
+                break;
+            case GameState::PAUSED:
+                break;
+        }
+    }
+
+    // App::updatePlaying
+    void updatePlaying(float dt) {
+        tickGraphDt = dt;
+        if (tickGraph.size() == 0) buildTickGraph();
+        tickGraph.run(JobSystem::getInstance());
+
+        if (player.isDead()) {
+            setState(GameState::PLAYER_DEAD);
+        } else if (enemies.allEnemiesDead() && enemies.getTotalCount() > 0) {
+            setState(GameState::ROOM_CLEARED);
+        }
+    }
+
+    // App::buildTickGraph: same task graph, each task timing itself
+    void buildTickGraph() {
+        float& dt = tickGraphDt;
+        auto playerTask = tickGraph.add([this, &dt]() {
+            auto t0 = Clock::now();
+            player.update(dt, &map);
+            camera.setPosition(player.getEyePosition() + player.getCameraOffset());
+            camera.update();
+            tickMs[PLAYER] += elapsedMs(t0, Clock::now());
+        });
+        auto weaponTask = tickGraph.add([this, &dt]() {
+            auto t0 = Clock::now();
+            weapon.update(dt, &map, &enemies);
+            tickMs[WEAPON] += elapsedMs(t0, Clock::now());
+        });
+        tickGraph.add([this, &dt]() {
+            auto t0 = Clock::now();
+            enemies.update(dt, player.getPosition(), &map);
+            float dps = enemies.getContactDps(player.getPosition());
+            if (dps > 0.0f) player.takeDamage(dps * dt);
+            tickMs[ENEMIES] += elapsedMs(t0, Clock::now());
+        }, {playerTask, weaponTask});
+        tickGraph.add([this, &dt]() {
+            auto t0 = Clock::now();
+            particles->update(dt);
+            tickMs[PARTICLES] += elapsedMs(t0, Clock::now());
+        });
+    }
+};
+
+// FNV-1a over the bits of the end state (player, enemies, bullets)
+uint64_t hashState(const HeadlessGame& game) {
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    glm::vec3 playerPos = game.player.getPosition();
+    float playerHp = game.player.getHp();
+    mix(&playerPos, sizeof(playerPos));
+    mix(&playerHp, sizeof(playerHp));
+    const EnemyPool& pool = game.enemies.getEnemies();
+    for (uint32_t slot = 0; slot < pool.getSlotCount(); ++slot) {
+        if (!pool.isLive(slot)) continue;
+        glm::vec3 pos = pool.getPosition(slot);
+        int hp = pool.getHp(slot);
+        mix(&pos, sizeof(pos));
+        mix(&hp, sizeof(hp));
+    }
+    size_t bullets = game.weapon.getActiveBulletCount();
+    mix(&bullets, sizeof(bullets));
+    return hash;
+}
+
+void printStats(const char* name, std::vector<double>& times, bool last) {
+    double sum = 0.0;
+    for (double t : times) sum += t;
+    std::sort(times.begin(), times.end());
+    double mean = sum / times.size();
+    double p50 = times[times.size() / 2];
+    double p99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    double ticksPerSec = sum > 0.0 ? times.size() * 1000.0 / sum : 0.0;
+    std::printf("    \"%s\": {\"ticksPerSec\": %.1f, \"meanMs\": %.6f, \"p50Ms\": %.6f, \"p99Ms\": %.6f, \"maxMs\": %.6f}%s\n",
+                name, ticksPerSec, mean, p50, p99, times.back(), last ? "" : ",");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mapPath = "res/maps/complex_base.json";
+    std::string replayPath;
+    int ticks = 3600;
+    int extraEnemies = 0;
+    bool hitscan = false;
+
+    // "--workers N" and "--trace file" may appear anywhere; the rest are positional
+    int workerThreads = GameConfig::getInstance().simulation.workerThreads;
+    std::string tracePath;
+    std::vector<const char*> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workerThreads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    InputRecording recording;
+    if (args.size() > 1 && std::strcmp(args[0], "--replay") == 0) {
+        replayPath = args[1];
+        if (!recording.load(replayPath)) return 1;
+        mapPath = recording.mapPath;
+        ticks = static_cast<int>(recording.ticks.size());
+
+        // Reproduce the recorded session's settings
+        auto& config = GameConfig::getInstance();
+        config.simulation.tickRate = recording.tickRate;
+        config.player.enableGodMode = recording.godMode;
+        seedParticleRandom(recording.seed);
+    } else {
+        if (args.size() > 0) mapPath = args[0];
+        if (args.size() > 1) ticks = std::max(1, std::atoi(args[1]));
+        if (args.size() > 2) extraEnemies = std::max(0, std::atoi(args[2]));
+        hitscan = args.size() > 3 && std::strcmp(args[3], "hitscan") == 0;
+        seedParticleRandom(1);
+    }
+    bool replaying = !replayPath.empty();
+
+    JobSystem::getInstance().start(workerThreads < 0 ? JobSystem::defaultWorkerCount()
+                                                     : static_cast<unsigned>(workerThreads));
+
+    const auto& sim = GameConfig::getInstance().simulation;
+    const float dt = 1.0f / std::max(sim.tickRate, 1.0f);
+
+    // Info goes to stdout, which must stay pure JSON; warnings and errors go to stderr
+    Logger::getInstance().setLevel(LogLevel::WARN);
+
+    Map map;
+    if (!map.loadFromFile(mapPath)) {
+        SILIC2_LOG_ERROR("headless_sim: failed to load map " << mapPath);
+        return 1;
+    }
+    addEnemySpawns(map, extraEnemies);
+
+    Entity* start = map.getPlayerStart();
+    glm::vec3 startPos = start ? start->position : glm::vec3(0.0f, 2.0f, 0.0f);
+
+    HeadlessGame game(map, startPos);
+    game.weapon.setFireMode(hitscan ? Weapon::FireMode::HITSCAN : Weapon::FireMode::PROJECTILE);
+
+    std::vector<double> times[SUBSYSTEM_COUNT];
+    for (auto& t : times) t.reserve(ticks);
+    size_t peakEnemies = 0, peakBullets = 0, restarts = 0;
+
+#if SILIC2_PROFILE
+    uint64_t tickAllocations = 0, peakTickAllocations = 0;   // Heap allocations after the first second
+    // One profiler frame per tick
+    if (!tracePath.empty()) Profiler::getInstance().captureFrames(ticks, tracePath);
+#else
+    if (!tracePath.empty()) SILIC2_LOG_WARN("headless_sim: built without the profiler, ignoring --trace");
+#endif
+
+    auto runStart = Clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        for (double& ms : game.tickMs) ms = 0.0;
+
+        auto t0 = Clock::now();
+        game.applyInput(replaying ? recording.ticks[t] : scriptedInput(t), dt);
+        game.update(dt);
+        game.tickMs[TOTAL] = elapsedMs(t0, Clock::now());
+#if SILIC2_PROFILE
+        Profiler::getInstance().endFrame();
+        if (t >= static_cast<int>(1.0f / dt)) {
+            uint64_t allocations = Profiler::getInstance().getSummary().frameAllocations;
+            tickAllocations += allocations;
+            peakTickAllocations = std::max(peakTickAllocations, allocations);
+        }
+#endif
+
+        for (int s = 0; s < SUBSYSTEM_COUNT; ++s) times[s].push_back(game.tickMs[s]);
+        peakEnemies = std::max(peakEnemies, game.enemies.getLiveCount());
+        peakBullets = std::max(peakBullets, game.weapon.getActiveBulletCount());
+
+        // Scripted runs keep the load steady: restart the fight once the room is cleared
+        if (!replaying && game.gameState == GameState::ROOM_CLEARED) {
+            game.enemies.spawnFromMap(map);
+            game.setState(GameState::PLAYING);
+            ++restarts;
+        }
+    }
+    double wallMs = elapsedMs(runStart, Clock::now());
+
+    Logger::getInstance().flush();
+
+    // Final player position and state hash: identical across runs of the same input,
+    // whatever the worker count
+    glm::vec3 endPos = game.player.getPosition();
+
+    std::printf("{\n");
+    std::printf("  \"map\": \"%s\",\n", mapPath.c_str());
+    if (replaying) std::printf("  \"replay\": \"%s\",\n", replayPath.c_str());
+    std::printf("  \"ticks\": %d,\n", ticks);
+    std::printf("  \"tickRate\": %.1f,\n", 1.0f / dt);
+    std::printf("  \"workerThreads\": %u,\n", JobSystem::getInstance().getWorkerCount());
+    std::printf("  \"realTimeFactor\": %.1f,\n", wallMs > 0.0 ? ticks * dt * 1000.0 / wallMs : 0.0);
+    std::printf("  \"fireMode\": \"%s\",\n",
+                game.weapon.getFireMode() == Weapon::FireMode::HITSCAN ? "hitscan" : "projectile");
+    std::printf("  \"enemySpawns\": %zu,\n", game.enemies.getTotalCount());
+    std::printf("  \"peakLiveEnemies\": %zu,\n", peakEnemies);
+    std::printf("  \"peakBullets\": %zu,\n", peakBullets);
+    std::printf("  \"restarts\": %zu,\n", restarts);
+#if SILIC2_PROFILE
+    std::printf("  \"heapAllocations\": {\"total\": %llu, \"peakPerTick\": %llu},\n",
+                static_cast<unsigned long long>(tickAllocations), static_cast<unsigned long long>(peakTickAllocations));
+#endif
+    std::printf("  \"endPosition\": [%.6f, %.6f, %.6f],\n", endPos.x, endPos.y, endPos.z);
+    std::printf("  \"stateHash\": \"%016llx\",\n", static_cast<unsigned long long>(hashState(game)));
+    std::printf("  \"subsystems\": {\n");
+    for (int s = 0; s < SUBSYSTEM_COUNT; ++s) {
+        printStats(SUBSYSTEM_NAMES[s], times[s], s == SUBSYSTEM_COUNT - 1);
+    }
+    std::printf("  }\n");
+    std::printf("}\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Particle update benchmark: ParticleSystem::update time against particle count
+// for every SIMD kernel the CPU supports.
+//
+// Keeps the system full the way ground fire does: particles with 1-3 s lifetimes,
+// topped up before every frame, so each update integrates N particles and
+// swap-removes the ones that expired. Only update() is timed. No window or GL
+// context is needed.
+//
+// A second table splits 100k particles over several systems, the way separate effects
+// are, and updates them one after another or as concurrent TaskGraph tasks.
+//
+// Usage: particle_bench [frames] [workers]
+
+#include "effects/particle_system.h"
+#include "effects/particle_kernels.h"
+#include "engine/job_system.h"
+#include "engine/log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace silic2;
+
+namespace {
+
+struct FrameStats {
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+// Refills a system to 'count' live particles
+void topUp(ParticleSystem& particles, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> spread(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> drift(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> rise(5.0f, 9.0f);
+    std::uniform_real_distribution<float> lifetime(1.0f, 3.0f);
+    while (particles.getActiveParticles() < count) {
+        particles.emit(glm::vec3(spread(rng), 0.0f, spread(rng)),
+                       glm::vec3(drift(rng), rise(rng), drift(rng)),
+                       glm::vec3(1.0f, 0.6f, 0.0f), lifetime(rng), 4.0f, 1.0f, 40.0f);
+    }
+}
+
+// Times 'frames' calls of 'update' after a warmup; 'refill' runs untimed before each
+FrameStats timeFrames(int frames, const std::function<void()>& refill, const std::function<void()>& update) {
+    std::vector<double> times;
+    times.reserve(frames);
+    const int warmup = 30;
+    for (int f = 0; f < warmup + frames; ++f) {
+        refill();
+        auto t0 = std::chrono::steady_clock::now();
+        update();
+        auto t1 = std::chrono::steady_clock::now();
+        if (f >= warmup) times.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+
+    FrameStats stats;
+    double sum = 0.0;
+    for (double t : times) sum += t;
+    std::sort(times.begin(), times.end());
+    stats.meanMs = sum / times.size();
+    stats.p50Ms = times[times.size() / 2];
+    stats.p99Ms = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    stats.maxMs = times.back();
+    return stats;
+}
+
+const float DT = 1.0f / 60.0f;
+
+FrameStats runCase(size_t count, ParticleKernel kernel, int frames) {
+    setParticleKernel(kernel);
+    ParticleSystem particles(count);
+    particles.setGravity(-0.2f);
+    std::mt19937 rng(1234);
+    return timeFrames(frames, [&]() { topUp(particles, count, rng); }, [&]() { particles.update(DT); });
+}
+
+FrameStats runSystemsCase(size_t systemCount, size_t totalCount, bool concurrent, int frames) {
+    size_t perSystem = totalCount / systemCount;
+    std::vector<std::unique_ptr<ParticleSystem>> systems;
+    TaskGraph graph;
+    for (size_t s = 0; s < systemCount; ++s) {
+        systems.push_back(std::make_unique<ParticleSystem>(perSystem));
+        systems.back()->setGravity(-0.2f);
+        ParticleSystem* system = systems.back().get();
+        graph.add([system]() { system->update(DT); });
+    }
+    std::mt19937 rng(1234);
+    auto refill = [&]() {
+        for (auto& system : systems) topUp(*system, perSystem, rng);
+    };
+    if (concurrent) {
+        return timeFrames(frames, refill, [&]() { graph.run(JobSystem::getInstance()); });
+    }
+    return timeFrames(frames, refill, [&]() {
+        for (auto& system : systems) system->update(DT);
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 300;
+    unsigned workers = argc > 2 ? static_cast<unsigned>(std::max(0, std::atoi(argv[2]))) : 0;
+
+    Logger::getInstance().setLevel(LogLevel::WARN);
+    JobSystem::getInstance().start(workers);
+
+    std::printf("%d frames per case, dt = 1/60 s, %u worker thread(s)\n", frames, workers);
+    std::printf("%9s  %-7s %9s %9s %9s %9s %12s\n",
+                "particles", "kernel", "mean ms", "p50 ms", "p99 ms", "max ms", "ns/particle");
+
+    const size_t counts[] = {1000, 10000, 100000, 250000};
+    const ParticleKernel kernels[] = {ParticleKernel::SCALAR, ParticleKernel::SSE2, ParticleKernel::AVX2};
+    for (size_t count : counts) {
+        for (ParticleKernel kernel : kernels) {
+            if (!isParticleKernelSupported(kernel)) continue;
+            FrameStats s = runCase(count, kernel, frames);
+            std::printf("%9zu  %-7s %9.3f %9.3f %9.3f %9.3f %12.2f\n",
+                        count, particleKernelName(kernel), s.meanMs, s.p50Ms, s.p99Ms, s.maxMs,
+                        s.meanMs * 1e6 / count);
+            std::fflush(stdout);
+        }
+    }
+
+    setParticleKernel(ParticleKernel::AVX2);   // Falls back to the best supported kernel
+    const size_t total = 100000;
+    std::printf("\n%zu particles over several systems, %s kernel\n", total, particleKernelName(getParticleKernel()));
+    std::printf("%9s  %-10s %9s %9s %9s %9s\n", "systems", "update", "mean ms", "p50 ms", "p99 ms", "max ms");
+    for (size_t systemCount : {1, 4, 8}) {
+        for (bool concurrent : {false, true}) {
+            FrameStats s = runSystemsCase(systemCount, total, concurrent, frames);
+            std::printf("%9zu  %-10s %9.3f %9.3f %9.3f %9.3f\n", systemCount, concurrent ? "task graph" : "serial",
+                        s.meanMs, s.p50Ms, s.p99Ms, s.maxMs);
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "effects/particle_kernels.h"
+#include <glm/glm.hpp>
+#include <glad/glad.h>
+#include <memory>
+#include <vector>
+
+namespace silic2 {
+
+class Shader;
+
+// Transform-feedback particle simulation behind ParticleSystem's GPU backend. Particle
+// state lives in two GPU buffers: each step the particle_sim vertex shader reads one,
+// integrates position, velocity and life, and writes the other. New particles are
+// written into a ring of slots, so once the ring is full the oldest slot is reused.
+// Nothing is read back; expired particles keep their slot and the draw shaders hide them.
+//
+// queueParticles() and queueStep() only touch CPU memory (one thread at a time, any
+// thread); everything else needs the GL context.
+class GpuParticleSim {
+public:
+    // Floats per particle: ParticleSystem's render streams in order, then gravity
+    static constexpr size_t PARTICLE_FLOATS = 14;
+    static constexpr size_t MAX_PENDING_STEPS = 64;   // Further steps merge into the last one
+
+    explicit GpuParticleSim(size_t capacity);
+    ~GpuParticleSim();
+
+    // Loads the shader and creates the buffers on the first call; false if that failed
+    bool init();
+
+    // Space for 'count' new particles (PARTICLE_FLOATS each), filled before the next flush()
+    float* queueParticles(size_t count);
+    void queueStep(const ParticleStep& step);
+
+    // Uploads queued particles and runs queued steps, in the order they were queued
+    void flush();
+
+    static void packParticle(float* out, const glm::vec3& position, const glm::vec3& velocity,
+                             const glm::vec3& color, float life, float size, float gravity, float fadeRatio);
+
+    GLuint getStateBuffer() const { return buffers[current]; }
+    size_t getSlotsInUse() const { return slotsInUse; }
+    // Slots in use once the queued particles are uploaded
+    size_t getParticleCount() const;
+    size_t getCapacity() const { return capacity; }
+
+private:
+    struct PendingStep {
+        ParticleStep step;
+        size_t particlesBefore;   // Queued particles emitted before this step
+    };
+
+    size_t capacity;
+    size_t ringHead = 0;          // Next slot to write
+    size_t slotsInUse = 0;        // Slots [0, slotsInUse) hold particles, live or expired
+    std::vector<float> pendingParticles;
+    std::vector<PendingStep> pendingSteps;
+
+    GLuint buffers[2] = {0, 0};
+    GLuint simVAOs[2] = {0, 0};   // simVAOs[i] reads buffers[i]
+    int current = 0;              // Buffer holding the latest state
+    bool initialized = false;
+    std::unique_ptr<Shader> simShader;
+
+    void uploadParticles(size_t first, size_t count);
+    void runStep(const ParticleStep& step);
+    void dropOldestQueued(size_t count);
+};
+
+} // namespace silic2
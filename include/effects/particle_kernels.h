@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace silic2 {
+
+// Per-particle streams the integrator touches, one float array each
+struct ParticleStreams {
+    float* posX;
+    float* posY;
+    float* posZ;
+    float* velX;
+    float* velY;
+    float* velZ;
+    float* life;        // Seconds left; dead at <= 0
+    const float* gravity;  // Multiplier on the system gravity
+};
+
+// Constants of one update step, pre-multiplied by the tick length
+struct ParticleStep {
+    float dt;
+    float gravityDt;    // System gravity * dt
+    glm::vec3 windDt;   // Wind acceleration * dt
+};
+
+enum class ParticleKernel : uint8_t {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Advances particles [begin, end): position by velocity, then gravity and wind into
+// velocity, then life. Every kernel does the same float operations in the same order
+// (no FMA), so results are identical whichever one runs.
+void integrateParticles(const ParticleStreams& streams, size_t begin, size_t end, const ParticleStep& step);
+
+// The kernel integrateParticles() uses: the widest one the CPU supports, unless
+// overridden. Requests for an unsupported kernel fall back to the best supported one.
+ParticleKernel getParticleKernel();
+void setParticleKernel(ParticleKernel kernel);
+bool isParticleKernelSupported(ParticleKernel kernel);
+const char* particleKernelName(ParticleKernel kernel);
+
+} // namespace silic2
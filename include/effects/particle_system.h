@@ -1,35 +1,73 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <array>
 #include <vector>
 #include <memory>
+#include <random>
+#include <cstdint>
 #include <glad/glad.h>
 #include "engine/map.h"
 
 namespace silic2 {
 
 class Shader;
+class GpuParticleSim;
 
-struct Particle {
-    glm::vec3 pPosition;
-    glm::vec3 pVelocity;
-    glm::vec3 pColor;
-    float pLife;         // Current life (0.0 = dead, 1.0 = full life)
-    float pMaxLife;      // Maximum life duration
-    float pSize;         // Particle size
-    float pGravity;      // Gravity effect multiplier
+// Reseeds every particle random stream (replays need identical sequences)
+void seedParticleRandom(uint32_t seed);
 
-    float pFadeRatio;
-    
-    Particle() : pPosition(0.0f), pVelocity(0.0f), pColor(1.0f),
-                 pLife(0.0f), pMaxLife(1.0f), pSize(1.0f), pGravity(1.0f), pFadeRatio(1.0f){}
-    
-    bool isAlive() const { return pLife > 0.0f; }
+// Random streams of the built-in effects. Effects that can update at the same time
+// need different streams; two systems on one stream draw identical sequences.
+enum class ParticleStream : uint32_t {
+    DEFAULT,
+    GROUND,
+    IMPACTS
+};
+
+// One effect's generator, seeded from the seedParticleRandom seed and its stream id.
+// Each system owns one, so systems can update on different threads and still draw
+// the same numbers on every run.
+class ParticleRandom {
+public:
+    explicit ParticleRandom(ParticleStream stream) : streamId(static_cast<uint32_t>(stream)) {}
+
+    float range(float min, float max);
+    uint32_t next();
+
+private:
+    uint32_t streamId;
+    uint32_t seedGeneration = UINT32_MAX;   // seedParticleRandom call the engine was seeded for
+    std::mt19937 engine;
+
+    void reseedIfStale();
+};
+
+// What emit() does when every slot is taken
+enum class ParticleOverflow : uint8_t {
+    DROP_NEW,         // Discard the new particle
+    RECYCLE_OLDEST,   // Overwrite the particle emitted longest ago
+    GROW              // Double the capacity
+};
+
+// Where particles are integrated
+enum class ParticleBackend : uint8_t {
+    CPU,    // SIMD kernels on the job system; the live range is uploaded every frame
+    GPU     // Transform feedback (GpuParticleSim); only new particles are uploaded
+};
+
+// What a particle does when its next step would enter solid cells of the collision grid.
+// Only entering counts: a particle spawned on a surface (already in a solid cell) gets out freely.
+enum class ParticleCollision : uint8_t {
+    NONE,     // Fly through geometry
+    KILL,     // Expire on contact
+    BOUNCE,   // Reflect the velocity off the blocked axes, scaled by the restitution
+    STICK     // Stop where it is; gravity no longer applies (wind still does)
 };
 
 class ParticleSystem {
 public:
-    ParticleSystem(size_t maxParticles = 1000);
+    ParticleSystem(size_t maxParticles = 1000, ParticleStream stream = ParticleStream::DEFAULT);
     ~ParticleSystem();
 
     // Update particles
@@ -42,7 +80,9 @@ public:
     void emit(const glm::vec3& position, const glm::vec3& velocity, 
               const glm::vec3& color, float life, float size , float pgravity, float fadeRatio = 1.0f);
     
-    // Batch emit particles (for efficiency)
+    // Batch emit particles (for efficiency). Slots are taken in order, then large bursts
+    // are filled in parallel chunks from counter-based randoms, so the result does not
+    // depend on how the chunks were spread over threads.
     void emitBurst(const glm::vec3& position, int count, 
                    const glm::vec3& baseVelocity, const glm::vec3& velocityVariation,
                    const glm::vec3& color, float life, float size , float pgravity, float fadeRatio = 1.0f);
@@ -51,20 +91,75 @@ public:
     void setGravity(float pgravity) { defaultGravity = pgravity; }
     void setWindForce(const glm::vec3& wind) { windForce = wind; }
     void setFadeOut(bool enabled) { fadeOutEnabled = enabled; }
+    void setOverflowPolicy(ParticleOverflow policy) { overflowPolicy = policy; }
+    ParticleOverflow getOverflowPolicy() const { return overflowPolicy; }
+
+    // World collision against a map's occupancy grid (null turns it off). The grid is
+    // not owned and must outlive the system or be replaced first. CPU backend only.
+    void setCollisionGrid(const OccupancyGrid* grid) { collisionGrid = grid; }
+    const OccupancyGrid* getCollisionGrid() const { return collisionGrid; }
+    void setCollisionResponse(ParticleCollision response) { collisionResponse = response; }
+    void setRestitution(float value) { restitution = value; }
+    ParticleCollision getCollisionResponse() const { return collisionResponse; }
+
+    // Switching drops live particles and must happen on the GL thread. The GPU backend
+    // always recycles the oldest slot when full and simulates on render(): update()
+    // only queues the step.
+    void setBackend(ParticleBackend newBackend);
+    ParticleBackend getBackend() const { return backend; }
+
+    // This system's random stream, for emitters that drive it
+    ParticleRandom& getRandom() { return random; }
     
     // Statistics
+    // GPU backend: slots in use, counting expired particles not yet replaced
     size_t getActiveParticles() const;
     size_t getMaxParticles() const { return maxParticleCount; }
+    size_t getDroppedParticles() const { return droppedCount; }
+
+    static constexpr size_t UPDATE_JOB_GRAIN = 8192;  // Particles per update job (a few microseconds each)
+    static constexpr size_t EMIT_JOB_GRAIN = 4096;    // Burst particles per emit job
 
 private:
-    std::vector<Particle> particles;
+    // Structure of arrays, one stream per attribute. Live particles are packed into
+    // [0, liveCount), so allocating is a bump of liveCount and releasing swaps the last
+    // live particle into the hole; the slots past liveCount are the free list. Each
+    // stream's live range is contiguous and uploads to the GPU with one copy.
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> life;            // Seconds left
+    std::vector<float> invMaxLife;      // 1 / starting life
+    std::vector<float> fadeRatio;       // Rendered color = color * lifeRatio^fadeRatio
+    std::vector<float> gravity;         // Multiplier on defaultGravity
+    std::vector<float> colorR, colorG, colorB;  // Color at full life
+    std::vector<float> size;
+    size_t liveCount = 0;
     size_t maxParticleCount;
-    size_t nextDeadParticle;
+
+    // Live particles in emission order, as a doubly linked list over stream indices,
+    // so RECYCLE_OLDEST finds its victim in O(1). Fixed up when a particle moves.
+    static constexpr uint32_t NO_PARTICLE = UINT32_MAX;
+    std::vector<uint32_t> olderLink, newerLink;
+    uint32_t oldestParticle = NO_PARTICLE;
+    uint32_t newestParticle = NO_PARTICLE;
+
+    ParticleOverflow overflowPolicy = ParticleOverflow::DROP_NEW;
+    size_t droppedCount = 0;
+
+    const OccupancyGrid* collisionGrid = nullptr;
+    ParticleCollision collisionResponse = ParticleCollision::NONE;
+    float restitution = 0.5f;           // Share of the blocked velocity kept by BOUNCE
+
+    ParticleRandom random;
+    std::vector<uint32_t> burstSlots;   // Slots taken by the emitBurst in progress
+
+    ParticleBackend backend = ParticleBackend::CPU;
+    std::unique_ptr<GpuParticleSim> gpuSim;
     
     // Rendering resources
-    GLuint VAO, VBO;
+    GLuint VAO;
     GLuint boxVAO, boxVBO;        // Box mesh for 3D particles
-    GLuint instanceVBO;           // Instance data buffer
+    GLuint gpuVAO, gpuBoxVAO;     // Same attributes, reading GpuParticleSim's state buffer
     std::unique_ptr<Shader> particleShader;
     std::unique_ptr<Shader> boxShader;      // Shader for 3D box particles
     bool use3DBoxes = true;       // Toggle between point sprites and 3D boxes
@@ -74,23 +169,30 @@ private:
     glm::vec3 windForce = glm::vec3(0.0f);
     bool fadeOutEnabled = true;
 
-    //Fade Settings
-    //A lookup Hash Table that stores precalculated values for lifeRatio^fadeRatio
-    //This way we prevent calculating std::pow on every particle
-    std::unordered_map<float, std::vector<float>> fadeLUTCache;
-    float lastFadeRatio = -1.0f;
-    int fadeOutSmoothness = 32; //Higher val = smoother fade transition
-    
-    // Rendering buffer
-    std::vector<float> vertexData;
-    std::vector<float> instanceData;  // For instanced rendering
+    // Every stream; the first RENDER_STREAMS are the ones the shaders read, in
+    // attribute order from their first particle location
+    static constexpr size_t STREAM_COUNT = 14;
+    static constexpr size_t RENDER_STREAMS = 13;
+    std::array<std::vector<float>*, STREAM_COUNT> streams();
     
     void initRenderingResources();
     void setupBoxMesh();
-    void updateVertexBuffer();
-    void updateInstanceBuffer();
-    size_t findDeadParticle();
-    const std::vector<float>& getFadeLUT(float fadeRatio);
+    void bindBoxMesh(GLuint vao);
+    // Render stream k is read at offset baseOffset + k * streamOffset with the given stride
+    void bindStreamAttributes(GLuint vao, GLuint buffer, GLuint firstLocation, GLuint divisor,
+                              size_t baseOffset, size_t streamOffset, GLsizei stride);
+    // Writes the live streams to the stream buffer and points the drawn VAO at them
+    bool uploadStreams(bool boxes);
+    void resizeStreams(size_t capacity);
+    size_t allocateParticle();
+    void writeParticle(size_t index, const glm::vec3& position, const glm::vec3& velocity,
+                       const glm::vec3& color, float life, float size, float pgravity, float fadeRatio);
+    void moveParticle(size_t from, size_t to);
+    void linkNewest(size_t index);
+    void unlink(size_t index);
+    void removeDeadParticles();
+    // Applies the collision response to particles [begin, end) whose next step enters geometry
+    void collideParticles(size_t begin, size_t end, float deltaTime);
 };
 
 class GroundParticleSystem {
@@ -103,7 +205,7 @@ public:
     GroundParticleSystem(size_t maxParticles = 500);
     ~GroundParticleSystem();
     
-    // Initialize with map floor surfaces
+    // Initialize with map floor surfaces; particles collide with the map's occupancy grid
     void initialize(const Map& map);
     
     // Update and render
@@ -115,6 +217,8 @@ public:
     void setFireIntensity(float intensity) { fireIntensity = intensity; }
     void setEnabled(bool enabled) { particleSystemEnabled = enabled; }
     void setParticleMode(GParticleMode mode){ currentMode = mode; }
+    void setBackend(ParticleBackend backend) { particleSystem->setBackend(backend); }
+    void setCollision(ParticleCollision response) { particleSystem->setCollisionResponse(response); }
     GParticleMode getParticleMode() const { return currentMode; }
     
     bool isEnabled() const { return particleSystemEnabled; }
@@ -4,9 +4,11 @@
 #include <memory>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
-#include "enemy/enemy.h"
+#include "enemy/enemy_pool.h"
 #include "engine/map.h"
 #include "engine/map_renderer.h"
+#include "engine/frame_arena.h"
+#include "engine/spatial_hash.h"
 
 namespace silic2 {
 
@@ -25,38 +27,86 @@ public:
 
     void update(float deltaTime, const glm::vec3& playerPos, const Map* map);
 
-    // Render all live enemies with the same point-light pipeline as the map
+    // Enemy-enemy separation steering (on by default)
+    void setSeparationEnabled(bool enabled) { separationEnabled = enabled; }
+    bool isSeparationEnabled() const { return separationEnabled; }
+
+    // Render all live enemies with the same point-light pipeline as the map.
+    // 'alpha' blends each enemy between its last two simulated positions
     void render(const glm::mat4& view, const glm::mat4& projection,
                 const glm::vec3& ambientLight,
-                const std::vector<MapRenderer::LightData>& lights);
+                const std::vector<MapRenderer::LightData>& lights,
+                float alpha = 1.0f);
 
-    // Returns true if the bullet segment (prevPos → pos) hit any live enemy; deals damage to it
-    bool checkBulletHit(const glm::vec3& prevPos, const glm::vec3& pos, int damage);
+    // Resolves a batch of bullet segments (prevPos → pos) against the live enemies in one pass.
+    // hits[s] is set for every segment that struck an enemy; the first enemy along each
+    // segment takes 'damage'. Damage is applied in segment order. If 'hitT' is given it is
+    // resized to match and receives the hit fraction along each segment that struck.
+    void checkBulletHits(const SegmentBatch& segments, int damage, std::vector<uint8_t>& hits,
+                         std::vector<float>* hitT = nullptr);
 
     // Returns total contact damage per second from all touching enemies
     float getContactDps(const glm::vec3& playerPos) const;
 
-    bool allEnemiesDead() const;
-    size_t getLiveCount()  const;
-    size_t getTotalCount() const { return enemies.size(); }
+    bool allEnemiesDead() const { return enemies.getLiveCount() == 0; }
+    size_t getLiveCount()  const { return enemies.getLiveCount(); }
+    size_t getTotalCount() const { return spawnedCount; }   // Spawned by the last spawnFromMap
+
+    // Returns positions of all live enemies, in frame memory
+    FrameVector<glm::vec3> getEnemyPositions(FrameArena& arena) const;
+
+    // Returns positions of live enemies within 'radius' of 'center' on XZ (used by minimap), in frame memory
+    FrameVector<glm::vec3> getEnemyPositions(const glm::vec3& center, float radius, FrameArena& arena) const;
 
-    // Returns XZ positions of all live enemies (used by minimap)
-    std::vector<glm::vec3> getEnemyPositions() const;
+    // Spatial hash of live enemies, keyed by slot in getEnemies()
+    const SpatialHash& getSpatialHash() const { return enemyHash; }
 
-    const std::vector<Enemy>& getEnemies() const { return enemies; }
+    const EnemyPool& getEnemies() const { return enemies; }
 
     void clear();
 
 private:
-    std::vector<Enemy> enemies;
+    EnemyPool enemies;
+    size_t spawnedCount = 0;
     std::unique_ptr<Shader> enemyShader;
+    std::vector<LightUniforms> lightUniforms;
     GLuint boxVAO = 0;
     GLuint boxVBO = 0;
 
+    // Live enemies, refreshed as they move; ids are slots in 'enemies'
+    SpatialHash enemyHash;
+
+    // Per-slot XZ push away from neighbours, computed from positions at the start of update()
+    std::vector<float> separationX;
+    std::vector<float> separationZ;
+    bool separationEnabled = true;
+    std::vector<uint32_t> separationCount;   // Live enemies per separation grid cell
+    std::vector<glm::vec2> separationSum;    // Sum of their XZ positions
+
+    // Per-job outputs of the parallel passes, merged serially afterwards
+    std::vector<uint8_t> enemyMoved;       // Slot moved this update (needs re-hashing)
+    std::vector<int32_t> segmentTargets;   // Nearest enemy slot per bullet segment at the start of the batch, or -1
+    std::vector<float>   segmentHitT;
+
+    // Query scratch (kept to avoid per-frame allocation)
+    mutable std::vector<uint32_t> nearbyEnemies;
+
     void setupBoxMesh();
-    void removeDeadEnemies();
+    void computeSeparation();
+    // Nearest live enemy along segment 's' (slot in 'enemies') and its hit fraction, or -1
+    int32_t findSegmentHit(const SegmentBatch& segments, size_t s, float& t) const;
 
     static constexpr float CONTACT_DPS = 20.0f; // HP/s per touching enemy
+
+    // Job sizes for the parallel passes
+    static constexpr size_t UPDATE_JOB_GRAIN = 64;   // Slots per update / separation job
+    static constexpr size_t BULLET_JOB_GRAIN = 16;   // Bullet segments per hit-test job
+
+    // Separation steering
+    static constexpr float    SEPARATION_RADIUS = 0.9f;          // XZ distance at which enemies start pushing apart
+    static constexpr float    SEPARATION_WEIGHT = 1.5f;          // Push strength relative to the chase direction
+    static constexpr uint32_t SEPARATION_MAX_CELL_WEIGHT = 4;    // A packed cell pushes like at most this many enemies
+    static constexpr float    SEPARATION_MAX_CELLS = 512.0f;     // Grid resolution cap per axis
 };
 
 } // namespace silic2
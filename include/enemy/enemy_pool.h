@@ -0,0 +1,90 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "enemy/enemy.h"
+#include "engine/collision.h"
+
+namespace silic2 {
+
+class Map;
+
+// Stable reference to an enemy: goes stale once its slot is released, even if
+// the slot is later reused
+struct EnemyHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+// Slot map of enemy simulation data in structure-of-arrays layout. Each field is
+// its own contiguous array indexed by slot; released slots go onto a free list
+// and are reused by the next spawn, so slots (and spatial-hash ids) never move.
+// The tick kernels walk slot ranges, so disjoint ranges can run as parallel jobs.
+class EnemyPool {
+public:
+    static constexpr int DEFAULT_HP = 3;
+
+    EnemyHandle spawn(const glm::vec3& position, int maxHp = DEFAULT_HP);
+    // Frees the slot for reuse; handles to it go stale
+    void release(uint32_t slot);
+    void clear();
+
+    size_t getSlotCount() const { return posX.size(); }   // Live and free slots
+    size_t getLiveCount() const { return liveCount; }
+
+    bool isLive(uint32_t slot) const { return slot < live.size() && live[slot]; }
+    bool isValid(EnemyHandle handle) const {
+        return isLive(handle.slot) && generation[handle.slot] == handle.generation;
+    }
+    EnemyHandle getHandle(uint32_t slot) const { return {slot, generation[slot]}; }
+    Enemy get(uint32_t slot) const { return Enemy(*this, slot); }
+
+    glm::vec3 getPosition(uint32_t slot) const { return glm::vec3(posX[slot], posY[slot], posZ[slot]); }
+    glm::vec3 getPrevPosition(uint32_t slot) const { return glm::vec3(prevX[slot], prevY[slot], prevZ[slot]); }
+    EnemyState getState(uint32_t slot) const { return state[slot]; }
+    int getHp(uint32_t slot) const { return hp[slot]; }
+    int getMaxHp(uint32_t slot) const { return maxHp[slot]; }
+    AABB getAABB(uint32_t slot) const;
+
+    // Returns true if this damage killed the enemy (the caller releases it)
+    bool takeDamage(uint32_t slot, int amount);
+
+    // One simulation tick for slots [begin, end): gravity and ground snap, chase
+    // plus separation steering, then wall-blocked horizontal movement.
+    // separationX/Z hold each slot's XZ push away from its neighbours; moved[s]
+    // is set for slots whose position changed.
+    void update(size_t begin, size_t end, float deltaTime, const glm::vec3& playerPos, const Map* map,
+                const float* separationX, const float* separationZ, uint8_t* moved);
+
+    // Live enemies within melee range of the player
+    size_t countTouching(const glm::vec3& playerPos) const;
+
+private:
+    // Per-slot fields
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> prevX, prevY, prevZ;   // Position at the start of the last tick (render interpolation)
+    std::vector<float> velocityY;             // Vertical velocity (gravity)
+    std::vector<float> moveX, moveZ;          // Desired horizontal move this tick
+    std::vector<int32_t> hp, maxHp;
+    std::vector<EnemyState> state;
+    std::vector<uint8_t> live;
+    std::vector<uint32_t> generation;
+
+    std::vector<uint32_t> freeSlots;
+    size_t liveCount = 0;
+
+    static constexpr float HALF_W      = Enemy::BOX_WIDTH * 0.5f;
+    static constexpr float MOVE_SPEED  = 3.0f;   // units/s horizontal
+    static constexpr float AGGRO_RANGE = 15.0f;  // player detection radius
+    static constexpr float GRAVITY     = -20.0f;
+    static constexpr float MAX_FALL    = -50.0f;
+    static constexpr float GROUND_EPS  = 0.05f;  // ground check extension
+
+    void applyGravityAndGround(uint32_t slot, float deltaTime, const Map* map);
+    bool checkGroundBelow(uint32_t slot, const Map* map) const;
+    // Moves by (moveX, moveZ) after wall collision resolution (axis-separated)
+    void moveHorizontal(uint32_t slot, const Map* map);
+};
+
+} // namespace silic2
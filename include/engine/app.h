@@ -4,6 +4,9 @@
 #include <string>
 #include "engine/camera.h"
 #include "engine/run_state.h"
+#include "engine/input_recording.h"
+#include "engine/frame_arena.h"
+#include "engine/job_system.h"
 
 // Forward declaration
 struct GLFWwindow;
@@ -20,6 +23,8 @@ class EnemyManager;
 class Crosshair;
 class Minimap;
 class HudRenderer;
+class ProfilerOverlay;
+class GpuProfiler;
 
 class App {
 public:
@@ -29,6 +34,13 @@ public:
     void run();
     bool loadMap(const std::string& mapFile);
 
+    // Record every tick's input to 'path' (written when run() returns), seeding all
+    // RNG from the recording. Call after loadMap().
+    bool startRecording(const std::string& path);
+    // Load a recording, its map and settings, and drive the game from it; the window
+    // closes when the last recorded tick has run
+    bool startReplay(const std::string& path);
+
 private:
     GLFWwindow* window;
     std::unique_ptr<Map> currentMap;
@@ -42,6 +54,12 @@ private:
     std::unique_ptr<Crosshair>    crosshair;
     std::unique_ptr<Minimap>      minimap;
     std::unique_ptr<HudRenderer>  hudRenderer;
+    std::unique_ptr<ProfilerOverlay> profilerOverlay;
+    std::unique_ptr<GpuProfiler>     gpuProfiler;      // Null when built without the profiler
+
+    // Transient render data (light lists, minimap vertices); reset at the start of render()
+    static constexpr size_t FRAME_ARENA_BYTES = 1 << 20;
+    FrameArena frameArena{FRAME_ARENA_BYTES};
 
     // Game state (replaces bool roomCleared / bool playerDead)
     GameState gameState  = GameState::PLAYING;
@@ -50,14 +68,39 @@ private:
 
     // Input edge-detection
     bool escWasPressed = false;
+    bool fireModeWasPressed = false;
+
+    // Profiler overlay (F3) and trace capture (F4); not part of the recorded input
+    bool showProfiler = false;
+    bool profilerKeyWasPressed = false;
+    bool traceKeyWasPressed = false;
 
-    // Timing
+    // Input source: live GLFW state, optionally recorded, or a replayed recording
+    enum class InputMode { LIVE, RECORDING, REPLAYING };
+    InputMode inputMode = InputMode::LIVE;
+    InputRecording recording;
+    std::string recordingPath;
+    size_t replayTick = 0;
+    glm::vec2 pendingLook = glm::vec2(0.0f);  // Mouse offset not yet consumed by a tick
+
+    // Timing: the simulation advances in fixed ticks of deltaTime; rendering blends
+    // between the last two ticks by renderAlpha
     float deltaTime = 0.0f;
     float lastFrame = 0.0f;
+    float accumulator = 0.0f;   // Frame time not yet simulated
+    float renderAlpha = 1.0f;
+    glm::vec3 prevCameraPosition = glm::vec3(0.0f);  // Camera position before the last tick
+
+    // Per-tick update tasks, built on the first PLAYING tick
+    TaskGraph tickGraph;
+    float tickGraphDt = 0.0f;
 
     bool initWindow();
     bool initOpenGL();
     void processInput();
+    void processProfilerKeys();
+    TickInput sampleInput();
+    void applyInput(const TickInput& input);
     void update(float deltaTime);
     void render();
     void cleanup();
@@ -65,6 +108,7 @@ private:
     // State helpers
     void setState(GameState next);
     void updatePlaying(float dt);
+    void buildTickGraph();
     void handleRoomCleared(float dt);
     void handlePlayerDead(float dt);
 
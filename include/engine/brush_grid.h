@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "engine/collision.h"
+
+namespace silic2 {
+
+struct BrushBounds;
+
+// Uniform grid over the XZ footprint of brush AABBs, built once per map load.
+// Movement code asks it for the brushes near a query box instead of scanning
+// the whole map; callers still run the exact AABB test on each candidate.
+class BrushGrid {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 2.0f;
+    static constexpr int   MAX_CELLS_PER_AXIS = 256;
+
+    void build(const BrushBounds& bounds, float cellSize = DEFAULT_CELL_SIZE);
+    void clear();
+
+    bool empty() const { return cellStart.empty(); }
+
+    // Replaces `out` with the indices of brushes whose XZ footprint touches the
+    // box, in ascending order without duplicates (same order as a full scan).
+    void query(const AABB& box, std::vector<uint32_t>& out) const;
+
+private:
+    float cellSize = DEFAULT_CELL_SIZE;
+    glm::vec2 origin = glm::vec2(0.0f);  // World XZ of cell (0, 0)
+    int cellsX = 0;
+    int cellsZ = 0;
+
+    // Compressed cell lists: brushes of cell c are cellItems[cellStart[c] .. cellStart[c + 1])
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellItems;
+
+    void cellRange(float minX, float minZ, float maxX, float maxZ,
+                   int& x0, int& z0, int& x1, int& z1) const;
+};
+
+} // namespace silic2
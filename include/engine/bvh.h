@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "engine/collision.h"
+
+namespace silic2 {
+
+struct BrushBounds;
+
+// Result of a segment query against the map
+struct SegmentHit {
+    bool hit = false;
+    float t = 1.0f;                          // Fraction along the segment [0, 1]
+    glm::vec3 point = glm::vec3(0.0f);       // World-space hit point
+    glm::vec3 normal = glm::vec3(0.0f);      // Face normal of the brush box that was hit
+    uint32_t brushIndex = 0;                 // Index into Map::getBrushes()
+};
+
+// Static bounding volume hierarchy over brush AABBs.
+// Built once per map load; answers "earliest hit" segment queries
+// in roughly logarithmic time instead of testing every brush.
+class BrushBVH {
+public:
+    void build(const BrushBounds& bounds);
+    void clear();
+
+    bool empty() const { return nodes.empty(); }
+    size_t getNodeCount() const { return nodes.size(); }
+
+    // Earliest intersection of the segment start -> end with any brush box
+    SegmentHit intersectSegment(const glm::vec3& start, const glm::vec3& end) const;
+
+private:
+    struct Node {
+        glm::vec3 min;
+        glm::vec3 max;
+        uint32_t leftOrFirst;  // Interior: index of left child (right = left + 1). Leaf: first item
+        uint32_t count;        // 0 for interior nodes, item count for leaves
+    };
+
+    struct BuildItem {
+        AABB box;
+        glm::vec3 centroid;
+        uint32_t brushIndex;
+    };
+
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> brushIndices;  // Leaf items, in tree order
+    std::vector<AABB> leafBoxes;         // Brush boxes copied in tree order for cache-friendly leaf tests
+
+    void subdivide(uint32_t nodeIndex, std::vector<BuildItem>& items);
+};
+
+} // namespace silic2
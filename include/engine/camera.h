@@ -4,8 +4,6 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "engine/game_config.h"
 
-struct GLFWwindow;
-
 namespace silic2 {
 
 class Camera {
@@ -13,7 +11,6 @@ public:
     Camera(glm::vec3 position = glm::vec3(0.0f, 5.0f, 5.0f));
 
     // Movement
-    void processKeyboard(GLFWwindow* window, float deltaTime);
     void processMouseMovement(float xoffset, float yoffset, bool constrainPitch = true);
     void processMouseScroll(float yoffset);
 
@@ -22,6 +19,8 @@ public:
 
     // Getters
     glm::mat4 getViewMatrix() const;
+    // View from 'eye' with the current orientation (render-interpolated position)
+    glm::mat4 getViewMatrix(const glm::vec3& eye) const;
     glm::mat4 getProjectionMatrix(float aspectRatio) const;
     glm::mat4 getProjectionMatrix(float aspectRatio, float customFov) const;
     glm::vec3 getPosition() const { return position; }
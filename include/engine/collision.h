@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
 namespace silic2 {
 
@@ -63,19 +65,62 @@ struct CollisionResult {
     CollisionResult(bool collided) : collided(collided) {}
 };
 
+// Boxes in SoA form for the batched segment tests (one contiguous array per bound)
+struct AABBBatch {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    size_t size() const { return minX.size(); }
+    void clear();
+    void reserve(size_t count);
+    void push(const AABB& box);
+};
+
+// Segments in SoA form (start -> end)
+struct SegmentBatch {
+    std::vector<float> startX, startY, startZ;
+    std::vector<float> endX, endY, endZ;
+
+    size_t size() const { return startX.size(); }
+    void clear();
+    void reserve(size_t count);
+    void push(const glm::vec3& start, const glm::vec3& end);
+};
+
 // Collision detection system
 class CollisionSystem {
 public:
     // AABB vs AABB collision detection
     static bool checkAABB(const AABB& a, const AABB& b);
     
-    // Moving AABB collision detection (sweep test)
+    // Overlap within this distance at the start of a sweep still counts as contact
+    static constexpr float SWEEP_CONTACT_TOLERANCE = 1e-3f;
+    
+    // Moving AABB collision detection (sweep test). On hit, distance is the time of
+    // impact in [0, deltaTime], point the moving box's centre at impact and normal
+    // the face of staticBox that was reached. Touching without penetrating is not a hit.
     static CollisionResult sweepAABB(const AABB& movingBox, const glm::vec3& velocity, 
                                      const AABB& staticBox, float deltaTime);
     
     // Ray vs AABB collision detection
     static CollisionResult raycastAABB(const Ray& ray, const AABB& box, float maxDistance = 1000.0f);
     
+    // Segment vs AABB slab test. On hit, tHit is the entry fraction along
+    // start -> end (0 if start is inside) and normal is the face that was entered.
+    static bool intersectSegmentAABB(const glm::vec3& start, const glm::vec3& end, const AABB& box,
+                                     float& tHit, glm::vec3& normal);
+    
+    // Batched segment vs AABB slab test. For every segment, finds the box entered
+    // first along start -> end (lowest index on ties). hitBox[s] is that box's index
+    // or -1, hitT[s] its entry fraction. Tests 8 (AVX2) or 4 (SSE) boxes at a time,
+    // picked at runtime, with a scalar fallback that gives identical results.
+    static void intersectSegmentsAABBs(const SegmentBatch& segments, const AABBBatch& boxes,
+                                       std::vector<int32_t>& hitBox, std::vector<float>& hitT);
+    
+    // Single-segment form of the batched test; returns the box index or -1
+    static int32_t intersectSegmentAABBs(const glm::vec3& start, const glm::vec3& end,
+                                         const AABBBatch& boxes, float& tHit);
+    
     // Get AABB penetration depth and separation vector
     static glm::vec3 getAABBPenetration(const AABB& a, const AABB& b);
     
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace silic2 {
+
+// Linear allocator for data that only lives until the end of the frame. allocate()
+// bumps an offset into one block and reset() rewinds it, so per-frame temporaries
+// cost no heap traffic. A frame that outgrows the block spills into extra heap
+// blocks; the next reset() frees them and grows the main block to fit, so only
+// the first heavy frames allocate. Not thread-safe: one arena per thread.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+    // Invalidates everything allocated since the last reset
+    void reset();
+
+    size_t getCapacity() const { return capacity; }
+    size_t getUsed() const { return used + overflowBytes; }
+    size_t getPeak() const { return peak; }       // Most bytes used by one frame
+
+private:
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity;
+    size_t used = 0;
+    size_t peak = 0;
+
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;   // Spill blocks, freed by reset()
+    size_t overflowBytes = 0;
+};
+
+// Standard allocator over a FrameArena; deallocate() is a no-op
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit FrameAllocator(FrameArena& frameArena) : arena(&frameArena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+
+    FrameArena* getArena() const { return arena; }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+// Vector in frame memory: build it, use it, and drop it before the arena resets
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <typename T>
+FrameVector<T> makeFrameVector(FrameArena& arena, size_t reserve = 0) {
+    FrameVector<T> v{FrameAllocator<T>(arena)};
+    v.reserve(reserve);
+    return v;
+}
+
+} // namespace silic2
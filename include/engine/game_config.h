@@ -21,6 +21,14 @@ struct RenderConfig {
     bool enableDepthTest = true;
 };
 
+struct SimulationConfig {
+    float tickRate = 60.0f;          // Fixed simulation steps per second
+    int maxTicksPerFrame = 5;        // Ticks run per rendered frame at most; older backlog is dropped
+    float maxFrameTime = 0.25f;      // Longer frames (hitches, debugger) are clamped to this
+    bool interpolate = true;         // Blend rendered positions between the last two ticks
+    int workerThreads = -1;          // Job system workers besides the main thread; -1 = one per extra core, 0 = serial
+};
+
 struct PlayerConfig {
     // Movement
     float moveSpeed = 5.0f;
@@ -74,6 +82,8 @@ struct EffectsConfig {
     bool enableGroundParticles = true;  // Enable/disable ground fire particles
     float groundParticleIntensity = 3.0f;  // Particle brightness multiplier
     float groundParticleEmissionRate = 100.0f;  // Particles per second
+    bool gpuParticles = false;  // Simulate ground particles with transform feedback
+    bool groundParticleCollision = true;  // Ground particles stop at map geometry (CPU backend)
 };
 
 class GameConfig {
@@ -83,6 +93,7 @@ public:
     // Configuration sections
     WindowConfig window;
     RenderConfig render;
+    SimulationConfig simulation;
     PlayerConfig player;
     CameraConfig camera;
     EffectsConfig effects;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace silic2 {
+
+// Timed sections of App::render, in draw order
+enum class GpuPass : uint8_t {
+    MAP,
+    BULLETS,
+    ENEMIES,
+    PARTICLES,
+    PIXEL_POST,   // Upscale of the low-res buffer to the window
+    HUD,
+    COUNT
+};
+
+// GPU time of one rendered frame
+struct GpuFrameStats {
+    static constexpr size_t PASS_COUNT = static_cast<size_t>(GpuPass::COUNT);
+
+    std::array<float, PASS_COUNT> passMs{};
+    float totalMs = 0.0f;
+    uint64_t frame = 0;        // Frame the numbers belong to (a few frames behind the current one)
+    bool valid = false;        // False until the first results arrive
+};
+
+// Per-pass GPU timing with GL_TIME_ELAPSED queries. Each frame uses its own query set
+// from a ring of FRAMES_IN_FLIGHT; a set is read back only when it comes round again
+// and the driver reports its results available, so reading never stalls the pipeline.
+// Passes must not nest (elapsed-time queries cannot overlap). Needs GL 3.3 or
+// ARB_timer_query, which Mesa's llvmpipe software renderer also provides.
+class GpuProfiler {
+public:
+    static constexpr size_t FRAMES_IN_FLIGHT = 3;
+
+    GpuProfiler() = default;
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Returns false (and every call becomes a no-op) without timer query support
+    bool init();
+    bool isSupported() const { return supported; }
+
+    // Collects the oldest finished frame, then starts recording a new one
+    void beginFrame();
+    void beginPass(GpuPass pass);
+    void endPass();
+    void endFrame();
+
+    const GpuFrameStats& getLatestStats() const { return latest; }
+    uint64_t getSkippedFrames() const { return skippedFrames; }
+
+    static const char* passName(GpuPass pass);
+
+private:
+    struct QuerySet {
+        std::array<GLuint, GpuFrameStats::PASS_COUNT> queries{};
+        std::array<bool, GpuFrameStats::PASS_COUNT> issued{};
+        uint64_t frame = 0;
+        bool pending = false;  // Issued and not read back yet
+    };
+
+    bool collect(QuerySet& set);
+
+    std::array<QuerySet, FRAMES_IN_FLIGHT> sets;
+    size_t current = 0;
+    uint64_t frameCounter = 0;
+    int activePass = -1;
+    bool supported = false;
+
+    GpuFrameStats latest;
+    uint64_t skippedFrames = 0;  // Sets reused before their results arrived
+};
+
+// Times its enclosing scope as one pass; a null profiler does nothing
+class GpuPassScope {
+public:
+    GpuPassScope(GpuProfiler* gpuProfiler, GpuPass pass) : profiler(gpuProfiler) {
+        if (profiler) profiler->beginPass(pass);
+    }
+    ~GpuPassScope() {
+        if (profiler) profiler->endPass();
+    }
+
+    GpuPassScope(const GpuPassScope&) = delete;
+    GpuPassScope& operator=(const GpuPassScope&) = delete;
+
+private:
+    GpuProfiler* profiler;
+};
+
+} // namespace silic2
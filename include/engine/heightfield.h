@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "engine/collision.h"
+
+namespace silic2 {
+
+struct BrushBounds;
+
+// 2D grid of walkable heights over the XZ plane, rasterised from brush tops once
+// per map load. Each cell lists the tops of the brushes covering it, sorted by
+// height, so stacked floors each keep their own entry. Ground checks look up the
+// few cells under a footprint and binary-search the height band they care about.
+class Heightfield {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 0.5f;
+    static constexpr int   MAX_CELLS_PER_AXIS = 512;
+
+    void build(const BrushBounds& bounds, float cellSize = DEFAULT_CELL_SIZE);
+    void clear();
+
+    bool empty() const { return cellStart.empty(); }
+
+    // Highest brush top among brushes whose AABB intersects 'probe' and whose top
+    // is at most 'maxTop'. Same result as testing every brush; false if none.
+    bool findGround(const AABB& probe, float maxTop, float& groundY) const;
+
+private:
+    // A brush top plus the rest of its AABB for the exact overlap test
+    struct Entry {
+        float top;
+        float bottom;
+        float minX, minZ;
+        float maxX, maxZ;
+    };
+
+    float cellSize = DEFAULT_CELL_SIZE;
+    glm::vec2 origin = glm::vec2(0.0f);  // World XZ of cell (0, 0)
+    int cellsX = 0;
+    int cellsZ = 0;
+
+    // Heights of cell c are entries[cellStart[c] .. cellStart[c + 1]), ascending by top
+    std::vector<uint32_t> cellStart;
+    std::vector<Entry> entries;
+
+    void cellRange(float minX, float minZ, float maxX, float maxZ,
+                   int& x0, int& z0, int& x1, int& z1) const;
+};
+
+} // namespace silic2
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "player/player.h"
+
+namespace silic2 {
+
+// Everything the simulation reads from the player during one tick
+struct TickInput {
+    PlayerInput player;
+    bool fire = false;                  // Left mouse button
+    bool toggleFireMode = false;        // Q
+    bool pause = false;                 // Esc
+    glm::vec2 look = glm::vec2(0.0f);   // Raw mouse offset since the previous tick (x right, y up)
+};
+
+// Per-tick input of a play session plus what is needed to reproduce it exactly:
+// the map, tick rate, RNG seed and starting god-mode flag.
+// On disk: a small header, then one record per tick with the buttons packed into
+// 16 bits, the look offset only when the mouse moved, and runs of identical idle
+// ticks merged into a repeat count. Values are stored in host byte order.
+struct InputRecording {
+    std::string mapPath;
+    uint32_t seed = 0;
+    float tickRate = 60.0f;
+    bool godMode = false;
+    std::vector<TickInput> ticks;
+
+    void clear();
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+} // namespace silic2
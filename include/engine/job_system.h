@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace silic2 {
+
+// Number of jobs still outstanding for one wait() call
+class JobCounter {
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+// Work-stealing thread pool. Every worker owns a fixed-size ring of job slots: it pushes
+// and pops its own jobs at the back and steals from the front of the others when it runs
+// dry. Jobs are a function pointer plus a small argument block stored in the slot, so
+// queuing never allocates; a job submitted to a full ring runs inline instead. The
+// thread that waits on a counter keeps running jobs instead of blocking, so jobs
+// may submit and wait on nested jobs. With no workers everything runs on the
+// calling thread inside wait().
+//
+// Jobs run in any order and on any thread: they must only read shared state and
+// write to their own outputs. Anything order-dependent (RNG, logging, container
+// edits) stays in the serial code around them, which keeps results identical to
+// a serial run.
+class JobSystem {
+public:
+    static JobSystem& getInstance();
+
+    ~JobSystem();
+
+    // Starts 'workerCount' worker threads next to the calling thread (restarts if running)
+    void start(unsigned workerCount);
+    void stop();
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    // One worker per hardware thread besides the caller
+    static unsigned defaultWorkerCount();
+
+    static constexpr size_t JOB_ARGS_SIZE = 32;       // Bytes a job's callable may capture
+    static constexpr size_t QUEUE_CAPACITY = 1024;    // Job slots per queue (power of two)
+
+    // Queues a copy of 'fn' and counts it in 'counter' until it has finished. The copy
+    // lives in the job slot, so 'fn' must be trivially copyable and fit JOB_ARGS_SIZE.
+    template <typename Fn>
+    void submit(const Fn& fn, JobCounter& counter) {
+        static_assert(sizeof(Fn) <= JOB_ARGS_SIZE && alignof(Fn) <= alignof(std::max_align_t),
+                      "job callable does not fit a job slot");
+        static_assert(std::is_trivially_copyable<Fn>::value, "job callable must be trivially copyable");
+        submit([](const void* args) { (*static_cast<const Fn*>(args))(); }, &fn, sizeof(Fn), counter);
+    }
+
+    using JobFn = void (*)(const void* args);
+    void submit(JobFn fn, const void* args, size_t argsSize, JobCounter& counter);
+
+    // Runs queued jobs on this thread until every job counted in 'counter' has finished
+    void wait(JobCounter& counter);
+
+    // Calls fn(begin, end) over [0, count) in chunks of at least 'grain' items and
+    // returns once all of them are done. Small ranges run inline on the caller.
+    // 'fn' is called by reference, never copied into a std::function, so no call allocates.
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, const Fn& fn) {
+        parallelFor(count, grain, [](const void* context, size_t begin, size_t end) {
+            (*static_cast<const Fn*>(context))(begin, end);
+        }, &fn);
+    }
+
+    using RangeFn = void (*)(const void* context, size_t begin, size_t end);
+    void parallelFor(size_t count, size_t grain, RangeFn fn, const void* context);
+
+private:
+    JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct Job {
+        JobFn fn;
+        JobCounter* counter;
+        alignas(std::max_align_t) unsigned char args[JOB_ARGS_SIZE];
+    };
+
+    // Jobs live in slots [head, head + count), wrapping at QUEUE_CAPACITY
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Job> slots = std::vector<Job>(QUEUE_CAPACITY);
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    static constexpr size_t CHUNKS_PER_THREAD = 4;   // parallelFor splits finer than the thread count to balance load
+
+    // queues[0] belongs to threads outside the pool (the main thread); queues[i + 1] to workers[i]
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs{0};
+    bool running = false;
+
+    size_t currentQueue() const;
+    bool popJob(size_t queue, Job& job);
+    bool runOneJob(size_t queue);
+    void workerLoop(size_t queue);
+};
+
+// Tasks with dependencies, run on a JobSystem. A task starts once every task it
+// depends on has finished; independent tasks run concurrently. The graph can be
+// run again after it finishes; a graph that is built once and rerun does not allocate.
+class TaskGraph {
+public:
+    using TaskId = size_t;
+
+    // 'dependencies' must name tasks added earlier
+    TaskId add(std::function<void()> fn, std::initializer_list<TaskId> dependencies = {});
+    void clear() { tasks.clear(); }
+    size_t size() const { return tasks.size(); }
+
+    void run(JobSystem& jobs);
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        std::vector<TaskId> dependents;
+        int dependencyCount = 0;
+    };
+
+    std::vector<Task> tasks;
+
+    // State of the run in progress
+    std::unique_ptr<std::atomic<int>[]> remaining;   // Unfinished dependencies per task
+    size_t remainingSize = 0;
+    JobSystem* runJobs = nullptr;
+    JobCounter* runCounter = nullptr;
+
+    void launch(TaskId id);
+};
+
+} // namespace silic2
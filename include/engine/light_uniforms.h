@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace silic2 {
+
+class Shader;
+
+// Shared light descriptor used by map, enemy, and any future lit pass
+struct LightData {
+    glm::vec3 position;
+    glm::vec3 color;
+    float intensity;
+    float range;
+};
+
+// Uniform locations of one lights[i] entry, looked up once per shader so the
+// per-frame upload builds no name strings
+struct LightUniforms {
+    GLint position, color, intensity, range;
+};
+
+constexpr int MAX_LIGHTS = 128;   // Size of the lights[] array in the lit shaders
+
+// Locations of lights[0 .. MAX_LIGHTS) in 'shader'
+std::vector<LightUniforms> findLightUniforms(const Shader& shader);
+
+// Uploads up to MAX_LIGHTS lights to the shader in use; returns how many were set
+int uploadLights(const std::vector<LightUniforms>& uniforms, const std::vector<LightData>& lights);
+
+} // namespace silic2
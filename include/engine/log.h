@@ -0,0 +1,179 @@
+#pragma once
+
+// Leveled logging. Build with -DSILIC2_LOG_MIN_LEVEL=n (make LOG_LEVEL=n) to compile every
+// call below level n out: 0 keeps everything, 1 drops DEBUG, 2 keeps WARN and ERROR.
+#ifndef SILIC2_LOG_MIN_LEVEL
+#define SILIC2_LOG_MIN_LEVEL 0
+#endif
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace silic2 {
+
+enum class LogLevel : uint8_t {
+    DEBUG,
+    INFO,
+    WARN,     // Written to stderr from here on
+    ERROR,
+    OFF
+};
+
+// Per-call-site budget: at most MESSAGES_PER_SECOND messages per wall-clock second.
+// The rest are counted and the count is appended to the next message that gets through.
+class LogSite {
+public:
+    static constexpr uint32_t MESSAGES_PER_SECOND = 20;
+
+    constexpr LogSite() = default;
+
+    bool allow();
+    // Messages dropped since the last call
+    uint32_t takeSuppressed() { return suppressed.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> second{0};
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+// Asynchronous console logger. Callers format into a fixed buffer on their own stack
+// and push it into a bounded lock-free queue (multi-producer, single consumer); a
+// background thread writes batches to stdout/stderr and flushes once per batch, so
+// logging never blocks on the console. A full queue drops the message and counts it.
+class Logger {
+public:
+    static constexpr size_t MESSAGE_BYTES = 496;   // Longer messages are truncated
+    static constexpr size_t QUEUE_SIZE = 1024;     // Power of two
+
+    static Logger& getInstance();
+
+    // Runtime filter on top of SILIC2_LOG_MIN_LEVEL
+    void setLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+    LogLevel getLevel() const { return minLevel.load(std::memory_order_relaxed); }
+    bool isEnabled(LogLevel level) const { return level >= getLevel(); }
+
+    void push(LogLevel level, const char* text, size_t length);
+
+    // Blocks until everything pushed so far has been written
+    void flush();
+
+    uint64_t getDroppedMessages() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Seconds since the logger was created
+    static uint32_t secondsNow();
+
+    // "debug", "info", "warn", "error", "off"; returns false for anything else
+    static bool parseLevel(const std::string& name, LogLevel& level);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        LogLevel level = LogLevel::INFO;
+        uint16_t length = 0;
+        char text[MESSAGE_BYTES];
+    };
+
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void writerLoop();
+    bool writeBatch();
+    static void write(LogLevel level, const char* text, size_t length);
+
+    std::array<Slot, QUEUE_SIZE> slots;
+    std::atomic<uint64_t> enqueuePos{0};
+    uint64_t dequeuePos = 0;                       // Writer thread only
+    std::atomic<uint64_t> written{0};              // Messages taken off the queue
+
+    std::atomic<LogLevel> minLevel{LogLevel::INFO};
+    std::atomic<uint64_t> dropped{0};
+    uint64_t reportedDropped = 0;                  // Writer thread only
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+};
+
+// One message under construction; pushed to the logger when it goes out of scope
+class LogLine {
+public:
+    LogLine(LogLevel lineLevel, LogSite& site) : level(lineLevel), suppressed(site.takeSuppressed()) {}
+    ~LogLine();
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(const char* text);
+    LogLine& operator<<(const unsigned char* text) { return *this << reinterpret_cast<const char*>(text); }
+    LogLine& operator<<(const std::string& text);
+    LogLine& operator<<(char c);
+    LogLine& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogLine& operator<<(double value);
+    LogLine& operator<<(const void* pointer);
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    LogLine& operator<<(T value) {
+        return std::is_signed<T>::value ? appendSigned(static_cast<long long>(value))
+                                        : appendUnsigned(static_cast<unsigned long long>(value));
+    }
+
+private:
+    LogLine& append(const char* text, size_t length);
+    LogLine& appendSigned(long long value);
+    LogLine& appendUnsigned(unsigned long long value);
+
+    LogLevel level;
+    uint32_t suppressed;
+    size_t length = 0;
+    bool truncated = false;
+    char text[Logger::MESSAGE_BYTES];
+};
+
+// SILIC2_LOG_INFO("Loaded " << count << " brushes"); the expression is only evaluated
+// when the level is enabled and the call site is within its rate limit.
+#define SILIC2_LOG(level, expr)                                                     \
+    do {                                                                            \
+        if (::silic2::Logger::getInstance().isEnabled(level)) {                     \
+            static ::silic2::LogSite silic2LogSite;                                 \
+            if (silic2LogSite.allow()) {                                            \
+                ::silic2::LogLine(level, silic2LogSite) << expr;                    \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+#if SILIC2_LOG_MIN_LEVEL <= 0
+#define SILIC2_LOG_DEBUG(expr) SILIC2_LOG(::silic2::LogLevel::DEBUG, expr)
+#else
+#define SILIC2_LOG_DEBUG(expr) ((void)0)
+#endif
+
+#if SILIC2_LOG_MIN_LEVEL <= 1
+#define SILIC2_LOG_INFO(expr) SILIC2_LOG(::silic2::LogLevel::INFO, expr)
+#else
+#define SILIC2_LOG_INFO(expr) ((void)0)
+#endif
+
+#if SILIC2_LOG_MIN_LEVEL <= 2
+#define SILIC2_LOG_WARN(expr) SILIC2_LOG(::silic2::LogLevel::WARN, expr)
+#else
+#define SILIC2_LOG_WARN(expr) ((void)0)
+#endif
+
+#if SILIC2_LOG_MIN_LEVEL <= 3
+#define SILIC2_LOG_ERROR(expr) SILIC2_LOG(::silic2::LogLevel::ERROR, expr)
+#else
+#define SILIC2_LOG_ERROR(expr) ((void)0)
+#endif
+
+} // namespace silic2
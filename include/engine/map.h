@@ -5,6 +5,11 @@
 #include <string>
 #include <memory>
 #include "engine/simple_json.h"
+#include "engine/collision.h"
+#include "engine/bvh.h"
+#include "engine/brush_grid.h"
+#include "engine/heightfield.h"
+#include "engine/occupancy_grid.h"
 
 namespace silic2 {
 
@@ -32,6 +37,36 @@ struct Brush {
     SurfaceType surfaceType = SurfaceType::UNKNOWN;  // Automatically determined from geometry
 };
 
+// World-space bounds of every brush, kept as a structure of arrays so that
+// collision queries can sweep them without re-scanning brush vertices.
+// Entry i always describes getBrushes()[i].
+struct BrushBounds {
+    enum Flags : uint8_t {
+        EMPTY           = 1 << 0,  // Brush has no vertices; never collides
+        FLAT_HORIZONTAL = 1 << 1   // Zero-thickness floor/ceiling quad
+    };
+
+    // Brushes thinner than this on Y count as flat horizontal surfaces
+    static constexpr float FLAT_THICKNESS = 0.01f;
+
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    std::vector<uint8_t> flags;
+
+    size_t size() const { return flags.size(); }
+    bool isEmpty(size_t i) const { return (flags[i] & EMPTY) != 0; }
+    bool isFlatHorizontal(size_t i) const { return (flags[i] & FLAT_HORIZONTAL) != 0; }
+
+    AABB getAABB(size_t i) const {
+        return AABB(glm::vec3(minX[i], minY[i], minZ[i]),
+                    glm::vec3(maxX[i], maxY[i], maxZ[i]));
+    }
+
+    void clear();
+    void reserve(size_t count);
+    void append(const Brush& brush);
+};
+
 enum class EntityType {
     PLAYER_START,
     LIGHT,
@@ -84,9 +119,15 @@ public:
 
     // Getters
     const WorldSettings& getWorldSettings() const { return worldSettings; }
+    const std::string& getFilename() const { return filename; }
     const std::vector<Brush>& getBrushes() const { return brushes; }
     const std::vector<Entity>& getEntities() const { return entities; }
     const std::vector<Light>& getLights() const { return lights; }
+    const BrushBounds& getBrushBounds() const { return brushBounds; }
+    const BrushBVH& getBrushBVH() const { return brushBVH; }
+    const BrushGrid& getBrushGrid() const { return brushGrid; }
+    const Heightfield& getHeightfield() const { return heightfield; }
+    const OccupancyGrid& getOccupancyGrid() const { return occupancyGrid; }
     
     // Geometry separation getters
     std::vector<const Brush*> getFloorBrushes() const;
@@ -100,7 +141,7 @@ public:
     
     // Modifiers (for editor)
     void setWorldSettings(const WorldSettings& settings) { worldSettings = settings; }
-    void addBrush(const Brush& brush) { brushes.push_back(brush); }
+    void addBrush(const Brush& brush);
     void addEntity(const Entity& entity) { entities.push_back(entity); }
     void addLight(const Light& light) { lights.push_back(light); }
     
@@ -117,6 +158,13 @@ private:
     std::vector<Entity> entities;
     std::vector<Light> lights;
     
+    // Cached collision data, rebuilt whenever the brush list changes
+    BrushBounds brushBounds;
+    BrushBVH brushBVH;
+    BrushGrid brushGrid;
+    Heightfield heightfield;
+    OccupancyGrid occupancyGrid;
+    
     std::string filename;
     bool loaded = false;
     
@@ -128,6 +176,8 @@ private:
     
     // Geometry analysis helpers
     void analyzeSurfaceTypes();
+    void rebuildBrushBounds();
+    void rebuildAccelerationStructures();
     SurfaceType determineSurfaceType(const Brush& brush);
     glm::vec3 calculateFaceNormal(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
     
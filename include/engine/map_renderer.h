@@ -5,6 +5,7 @@
 #include <glad/glad.h>
 #include "engine/map.h"
 #include "engine/texture.h"
+#include "engine/light_uniforms.h"
 
 namespace silic2 {
 
@@ -27,13 +28,7 @@ struct RenderableBrush {
 
 class MapRenderer {
 public:
-    // Shared light descriptor used by map, enemy, and any future lit pass
-    struct LightData {
-        glm::vec3 position;
-        glm::vec3 color;
-        float intensity;
-        float range;
-    };
+    using LightData = silic2::LightData;
 
     MapRenderer();
     ~MapRenderer();
@@ -59,6 +54,7 @@ public:
 private:
     std::vector<std::unique_ptr<RenderableBrush>> renderableBrushes;
     std::unique_ptr<Shader> mapShader;
+    std::vector<LightUniforms> mapLightUniforms;
 
     // Current map data
     const Map* currentMap = nullptr;
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace silic2 {
+
+struct BrushBounds;
+
+// Coarse 3D voxel grid with one bit per cell: set when any brush AABB touches the
+// cell. Rasterised once per map load for particle-vs-world tests, which only need
+// "is this point in geometry" and can afford a cell of slop. Our walls and floors are
+// zero-thickness quads, so every brush marks at least one layer of cells; the origin
+// sits half a cell off the map bounds so planes on whole-cell coordinates mark one.
+class OccupancyGrid {
+public:
+    static constexpr float  DEFAULT_CELL_SIZE = 0.25f;
+    static constexpr size_t MAX_CELLS = size_t(1) << 24;   // 2 MiB of bits; cells grow past it
+
+    void build(const BrushBounds& bounds, float cellSize = DEFAULT_CELL_SIZE);
+    void clear();
+
+    bool empty() const { return bits.empty(); }
+    float getCellSize() const { return cellSize; }
+    size_t getSolidCells() const { return solidCells; }
+
+    // True if 'p' is in a solid cell; everything outside the grid is empty
+    bool isSolid(const glm::vec3& p) const {
+        glm::vec3 c = (p - origin) * invCellSize;
+        // Written so NaN fails too
+        if (!(c.x >= 0.0f && c.y >= 0.0f && c.z >= 0.0f)) return false;
+        int x = static_cast<int>(c.x);
+        int y = static_cast<int>(c.y);
+        int z = static_cast<int>(c.z);
+        if (x >= cellsX || y >= cellsY || z >= cellsZ) return false;
+        size_t cell = (static_cast<size_t>(y) * cellsZ + z) * cellsX + x;
+        return (bits[cell >> 6] >> (cell & 63)) & 1;
+    }
+
+private:
+    float cellSize = DEFAULT_CELL_SIZE;
+    float invCellSize = 1.0f / DEFAULT_CELL_SIZE;
+    glm::vec3 origin = glm::vec3(0.0f);  // World position of cell (0, 0, 0)'s minimum corner
+    int cellsX = 0;
+    int cellsY = 0;
+    int cellsZ = 0;
+    size_t solidCells = 0;
+
+    // Cell (x, y, z) is bit (y * cellsZ + z) * cellsX + x
+    std::vector<uint64_t> bits;
+};
+
+} // namespace silic2
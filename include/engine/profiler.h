@@ -0,0 +1,138 @@
+#pragma once
+
+// CPU zone profiler. Build with -DSILIC2_PROFILE=0 (make PROFILE=0) to compile every
+// zone and the profiler itself out.
+#ifndef SILIC2_PROFILE
+#define SILIC2_PROFILE 1
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace silic2 {
+
+// One finished zone. 'name' must outlive the profiler (use string literals).
+struct ProfileEvent {
+    const char* name = nullptr;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+};
+
+// Rolling per-zone timings for the on-screen overlay
+struct ProfileSummary {
+    static constexpr size_t HISTORY_FRAMES = 120;
+
+    std::vector<const char*> zoneNames;          // In order of first appearance
+    std::vector<float> zoneMs;                   // Smoothed time per frame, summed over all threads
+    std::array<float, HISTORY_FRAMES> frameMs{}; // Frame-to-frame time, oldest at frameCursor
+    size_t frameCursor = 0;
+
+    uint64_t frameAllocations = 0;               // Heap allocations during the last frame (all threads)
+    uint64_t frameAllocatedBytes = 0;
+};
+
+#if SILIC2_PROFILE
+
+// Calls to the global operator new since startup, from every thread. Counted by the
+// replacement operators in alloc_counter.cpp (aligned new is not counted).
+struct AllocationStats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+AllocationStats getAllocationStats();
+
+// Collects zones from every thread. Each thread writes finished zones into its own
+// fixed ring buffer and publishes them with a single atomic store, so recording
+// never locks or allocates; endFrame() on the main thread drains all rings.
+class Profiler {
+public:
+    static Profiler& getInstance();
+
+    // Nanoseconds since the profiler was created
+    static uint64_t now();
+
+    // Called from ProfileZone's destructor on the recording thread
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Drains every thread's ring, updates the summary and feeds a running capture.
+    // Call once per frame from the main thread.
+    void endFrame();
+
+    // Records the next 'frames' frames and writes them as Chrome trace JSON
+    // (chrome://tracing, Perfetto) to 'path'. Replaces a capture in progress.
+    void captureFrames(size_t frames, const std::string& path);
+    bool isCapturing() const { return captureFramesLeft > 0; }
+
+    const ProfileSummary& getSummary() const { return summary; }
+    uint64_t getDroppedEvents() const { return droppedEvents; }
+
+private:
+    static constexpr size_t RING_SIZE = 8192;      // Zones per thread between two endFrame() calls
+    static constexpr float SMOOTHING = 0.1f;       // Weight of the newest frame in zoneMs
+
+    struct ThreadRing {
+        std::array<ProfileEvent, RING_SIZE> events;
+        std::atomic<uint64_t> written{0};          // Total events published by the owner
+        uint64_t read = 0;                         // Total events drained (main thread only)
+        uint32_t threadIndex = 0;
+    };
+
+    struct CapturedEvent {
+        ProfileEvent event;
+        uint32_t threadIndex;
+    };
+
+    Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    ThreadRing& threadRing();
+    size_t zoneIndex(const char* name);
+    bool writeChromeTrace(const std::string& path) const;
+
+    std::mutex ringsMutex;                          // Guards 'rings' (registration only)
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+
+    ProfileSummary summary;
+    std::vector<float> frameZoneMs;                 // Scratch for endFrame()
+    uint64_t lastFrameNs = 0;
+    AllocationStats lastAllocations;
+    uint32_t mainThreadIndex = 0;                   // Ring of the thread calling endFrame()
+    uint64_t droppedEvents = 0;
+
+    size_t captureFramesLeft = 0;
+    std::string capturePath;
+    std::vector<CapturedEvent> captured;
+};
+
+// Times its enclosing scope
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* zoneName) : name(zoneName), start(Profiler::now()) {}
+    ~ProfileZone() { Profiler::getInstance().record(name, start, Profiler::now()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define SILIC2_PROFILE_CONCAT_INNER(a, b) a##b
+#define SILIC2_PROFILE_CONCAT(a, b) SILIC2_PROFILE_CONCAT_INNER(a, b)
+#define SILIC2_PROFILE_ZONE(name) ::silic2::ProfileZone SILIC2_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+
+#else
+
+#define SILIC2_PROFILE_ZONE(name) ((void)0)
+
+#endif
+
+} // namespace silic2
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 
@@ -11,6 +12,9 @@ public:
     unsigned int ID;
     
     Shader(const char* vertexPath, const char* fragmentPath);
+    // Vertex-only program whose outputs are captured by transform feedback, interleaved
+    // in the order given
+    Shader(const char* vertexPath, const std::vector<const char*>& feedbackVaryings);
     ~Shader();
     
     void use() const;
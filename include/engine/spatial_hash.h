@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "engine/collision.h"
+
+namespace silic2 {
+
+// Hashed XZ grid for moving objects (enemies). Items are keyed by a dense id and
+// keep their AABB; update() only re-buckets an item when the set of cells it
+// covers changes, so per-frame refreshes are cheap. Cells are hashed, so the
+// world has no fixed extent.
+class SpatialHash {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 2.0f;
+
+    explicit SpatialHash(float cellSize = DEFAULT_CELL_SIZE);
+
+    void clear();
+
+    void insert(uint32_t id, const AABB& box);
+    void update(uint32_t id, const AABB& box);
+    void remove(uint32_t id);
+
+    bool contains(uint32_t id) const { return id < items.size() && items[id].active; }
+    const AABB& getAABB(uint32_t id) const { return items[id].box; }
+    size_t size() const { return activeCount; }
+
+    // All queries replace `out` with ids in ascending order without duplicates.
+
+    // Items whose box overlaps `box`
+    void queryBox(const AABB& box, std::vector<uint32_t>& out) const;
+
+    // Items whose box comes within `radius` of `center` on the XZ plane
+    void queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+
+    // Items in the cells crossed by start -> end (candidates; run the exact test on them)
+    void querySegment(const glm::vec3& start, const glm::vec3& end, std::vector<uint32_t>& out) const;
+
+private:
+    struct Item {
+        AABB box;
+        int x0 = 0, z0 = 0, x1 = -1, z1 = -1;  // Covered cell range
+        bool active = false;
+    };
+
+    float cellSize;
+    float invCellSize;
+    std::vector<Item> items;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+    size_t activeCount = 0;
+
+    int cellCoord(float v) const;
+    static uint64_t cellKey(int x, int z);
+
+    void addToCells(uint32_t id, const Item& item);
+    void removeFromCells(uint32_t id, const Item& item);
+    void appendCell(int x, int z, std::vector<uint32_t>& out) const;
+    static void sortUnique(std::vector<uint32_t>& out);
+};
+
+} // namespace silic2
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace silic2 {
+
+// Where one write into the stream buffer landed. 'buffer' may change between frames
+// (the buffer grows), so callers point their attributes at it after every write.
+struct StreamSlice {
+    void* data = nullptr;      // Mapped memory, valid until unmap(); null if mapping failed
+    GLuint buffer = 0;
+    size_t offset = 0;         // Byte offset of 'data' in 'buffer'
+};
+
+// Shared ring buffer for per-frame vertex and instance data. One GL buffer is split
+// into FRAMES_IN_FLIGHT regions; each frame appends to its own region with unsynchronized
+// glMapBufferRange, so writes never wait on the driver or force a copy. endFrame() fences
+// the region and moves to the next one, waiting only if the GPU still reads it.
+// Persistent mapping needs GL 4.4, so on our 3.3 context each write maps its range and
+// unmaps it before drawing. Main thread only, with the GL context current.
+class StreamBuffer {
+public:
+    static constexpr size_t FRAMES_IN_FLIGHT = 3;
+    static constexpr size_t DEFAULT_REGION_BYTES = 1 << 20;   // Per frame; doubles on overflow
+
+    static StreamBuffer& getInstance();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Reserves 'bytes' in this frame's region and maps them for writing. Call unmap()
+    // before any draw reads the slice.
+    StreamSlice map(size_t bytes, size_t alignment = 16);
+    void unmap();
+    // map(), copy, unmap()
+    StreamSlice upload(const void* data, size_t bytes, size_t alignment = 16);
+
+    // Fences this frame's writes and moves to the next region; once per frame, after the last draw
+    void endFrame();
+    // Frees the GL objects; before the context goes away
+    void shutdown();
+
+    size_t getRegionBytes() const { return regionBytes; }
+    uint64_t getStalledFrames() const { return stalledFrames; }
+
+private:
+    StreamBuffer() = default;
+
+    void allocate(size_t bytesPerRegion);
+
+    GLuint buffer = 0;
+    size_t regionBytes = 0;
+    size_t region = 0;         // Region this frame writes
+    size_t head = 0;           // Bytes used in it
+    bool mapped = false;
+    std::array<GLsync, FRAMES_IN_FLIGHT> fences{};
+    uint64_t stalledFrames = 0;   // endFrame() calls that had to wait for the GPU
+};
+
+} // namespace silic2
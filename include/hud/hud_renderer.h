@@ -1,14 +1,11 @@
 #pragma once
 #include <vector>
-#include <memory>
-#include <glad/glad.h>
 #include <glm/glm.hpp>
-#include "enemy/enemy.h"
+#include "enemy/enemy_pool.h"
+#include "hud/rect_batch.h"
 
 namespace silic2 {
 
-class Shader;
-
 class HudRenderer {
 public:
     HudRenderer();
@@ -18,18 +15,13 @@ public:
 
     void render(int screenW, int screenH,
                 float playerHp, float playerMaxHp,
-                const std::vector<Enemy>& enemies,
+                const EnemyPool& enemies,
                 const glm::mat4& view,
-                const glm::mat4& projection);
+                const glm::mat4& projection,
+                float alpha = 1.0f);  // Enemy position blend, as in EnemyManager::render
 
 private:
-    GLuint vao = 0;
-    GLuint vbo = 0;
-    std::unique_ptr<Shader> shader;
-
-    // Draw a filled rectangle. x,y = top-left corner in screen pixels (Y-down).
-    void drawRect(float x, float y, float w, float h,
-                  const glm::vec4& col, int screenW, int screenH);
+    RectBatch rects;  // Every bar of a frame, drawn in one call
 
     static glm::vec4 hpColor(float ratio);  // green > 60%, yellow > 30%, red otherwise
 };
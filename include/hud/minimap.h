@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include <vector>
+#include "engine/frame_arena.h"
 
 namespace silic2 {
 
@@ -20,11 +21,15 @@ public:
     // Call once after a map loads — prebuilds static wall geometry in world space.
     void setMap(const Map* map);
 
-    // Call every frame after endPixelRender().
+    // Call every frame after endPixelRender(). Per-frame vertices go into 'arena'.
     void render(const glm::vec3& playerPos,
                 const glm::vec3& playerFront,
-                const std::vector<glm::vec3>& enemyPositions,
-                int screenW, int screenH);
+                const FrameVector<glm::vec3>& enemyPositions,
+                int screenW, int screenH,
+                FrameArena& arena);
+
+    // World-space radius around the player whose enemies can show on the minimap
+    float getEnemyQueryRadius() const { return VIEW_RADIUS * (1.0f + CIRCLE_R); }
 
 private:
     std::unique_ptr<Shader> shader;
@@ -34,12 +39,14 @@ private:
     int    mapVertCount = 0;
 
     // Dynamic geometry per frame: background + enemies + player arrow.
-    GLuint dynVAO = 0, dynVBO = 0;
+    GLuint dynVAO = 0;
 
     void buildMapGeometry(const Map* map);
 
     // How many world units the minimap radius covers.
     static constexpr float VIEW_RADIUS = 25.0f;
+    // Enemy circle radius in minimap-normalised [0,1] space.
+    static constexpr float CIRCLE_R = 0.045f;
     // Minimap size and screen margin in pixels.
     static constexpr float MARGIN = 10.0f;
     static constexpr float SIZE   = 180.0f;
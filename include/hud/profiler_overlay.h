@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "engine/profiler.h"
+#include "engine/gpu_profiler.h"
+#include "hud/rect_batch.h"
+
+namespace silic2 {
+
+// Debug bar graph of the profiler summary, drawn top-left at native resolution:
+// a frame-time history strip with a 60 Hz budget line, one bar per CPU zone, then
+// one bar per GPU pass. A corner light turns red on frames that hit the heap.
+// There is no text rendering, so App prints the zone legend when the overlay opens.
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+    ~ProfilerOverlay();
+
+    bool init();
+
+    // 'gpu' may be null (no timer queries); invalid stats draw no GPU bars
+    void render(int screenW, int screenH, const ProfileSummary& summary, const GpuFrameStats* gpu);
+
+    // Bar color of zone or GPU pass row 'index' (the palette repeats)
+    static glm::vec4 zoneColor(size_t index);
+    static const char* zoneColorName(size_t index);
+
+private:
+    RectBatch rects;
+
+    static constexpr float MARGIN       = 10.0f;
+    static constexpr float WIDTH        = 240.0f;   // Pixels for BUDGET_MS in the zone bars
+    static constexpr float GRAPH_HEIGHT = 60.0f;    // Pixels for 2 * BUDGET_MS in the history strip
+    static constexpr float BAR_HEIGHT   = 6.0f;
+    static constexpr float BUDGET_MS    = 1000.0f / 60.0f;
+};
+
+} // namespace silic2
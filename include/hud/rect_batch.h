@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <memory>
+#include "engine/stream_buffer.h"
+
+namespace silic2 {
+
+class Shader;
+
+// Solid screen-space rectangles for the HUD passes. begin() maps one stream buffer
+// slice, add() writes each rectangle straight into it, and end() unmaps and draws the
+// whole batch with one call. Coordinates are pixels with a top-left origin. Nothing else
+// may map the stream buffer between begin() and end().
+class RectBatch {
+public:
+    static constexpr size_t FLOATS_PER_VERTEX = 6;   // x, y, r, g, b, a
+    static constexpr size_t VERTICES_PER_RECT = 6;   // Two triangles
+
+    RectBatch();
+    ~RectBatch();
+
+    bool init();
+
+    // Room for up to 'maxRects' rectangles; false (and add() ignored) if mapping failed
+    bool begin(size_t maxRects);
+    void add(float x, float y, float w, float h, const glm::vec4& color);
+    void end(int screenW, int screenH);
+
+private:
+    std::unique_ptr<Shader> shader;
+    GLuint vao = 0;
+
+    StreamSlice slice;
+    size_t capacity = 0;   // Rectangles the mapped slice holds
+    size_t count = 0;      // Rectangles written so far
+};
+
+} // namespace silic2
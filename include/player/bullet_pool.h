@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace silic2 {
+
+// Fixed-capacity projectile storage in structure-of-arrays layout. All storage is
+// allocated up front; spawn() appends and remove() moves the last bullet into the
+// freed index, so both are O(1) and never touch the heap. Indices are therefore
+// not stable across remove().
+class BulletPool {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    explicit BulletPool(size_t capacity = DEFAULT_CAPACITY);
+
+    // Returns false (the bullet is dropped) when the pool is full
+    bool spawn(const glm::vec3& position, const glm::vec3& velocity);
+    void remove(size_t index);
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return position.size(); }
+    bool empty() const { return count == 0; }
+
+    const glm::vec3& getPosition(size_t i) const { return position[i]; }
+    const glm::vec3& getPrevPosition(size_t i) const { return prevPosition[i]; }
+    const glm::vec3& getVelocity(size_t i) const { return velocity[i]; }
+    float getLifetime(size_t i) const { return lifetime[i]; }   // Seconds since spawn
+
+    // Moves bullets [begin, end) one tick and ages them
+    void integrate(size_t begin, size_t end, float deltaTime);
+
+private:
+    std::vector<glm::vec3> position;
+    std::vector<glm::vec3> prevPosition;  // Position last tick — used for swept collision
+    std::vector<glm::vec3> velocity;
+    std::vector<float> lifetime;
+    size_t count = 0;
+};
+
+} // namespace silic2
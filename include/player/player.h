@@ -4,8 +4,7 @@
 #include "engine/collision.h"
 #include "engine/game_config.h"
 #include <memory>
-
-struct GLFWwindow;
+#include <vector>
 
 namespace silic2 {
 
@@ -23,6 +22,18 @@ enum class PlayerState {
     SLIDING
 };
 
+// Player controls for one update, sampled from the keyboard by App or scripted by
+// headless runs. Edge-triggered actions (toggles, jump) are detected by Player.
+struct PlayerInput {
+    bool forward = false;   // W
+    bool back    = false;   // S
+    bool left    = false;   // A
+    bool right   = false;   // D
+    bool jump    = false;   // Space; flies up in god mode
+    bool sprint  = false;   // Left Shift toggles sprint; flies down in god mode
+    bool crouch  = false;   // Left Ctrl: crouch, or slide when fast enough
+    bool godMode = false;   // G toggles god mode
+};
 
 class Player {
 public:
@@ -33,7 +44,7 @@ public:
     void update(float deltaTime, const Map* map);
     
     // Process input
-    void processInput(GLFWwindow* window, Camera* camera, float deltaTime);
+    void processInput(const PlayerInput& input, Camera* camera, float deltaTime);
     void processMouseMovement(Camera* camera, float xoffset, float yoffset);
     
     // Get player position
@@ -129,20 +140,24 @@ private:
     // Sprint toggle system
     bool sprintToggled = false;             // Sprint state (toggled by Shift)
     
+    // Broadphase scratch: brush indices near the current collision query
+    std::vector<uint32_t> nearbyBrushes;
+    
+    // Collide-and-slide tuning
+    static constexpr int   MAX_SLIDE_PLANES = 4;      // Contact planes resolved per move
+    static constexpr float COLLISION_SKIN   = 0.001f; // Gap kept between the player box and surfaces
+    
     // Physics update
     void updatePhysics(float deltaTime, const Map* map);
     
-    // Handle collision with map
-    void handleMapCollision(const Map* map);
-    
     // Check if on ground
     bool checkGroundCollision(const Map* map);
     
-    // Move with collision detection
+    // Swept collide-and-slide against nearby brushes, including step-up; returns the actual movement
     glm::vec3 moveWithCollision(const glm::vec3& movement, const Map* map);
     
     // Get movement input
-    glm::vec3 getMovementInput(GLFWwindow* window, Camera* camera, float deltaTime);
+    glm::vec3 getMovementInput(const PlayerInput& input, Camera* camera, float deltaTime);
     
     // Update FOV based on sprinting state
     void updateFov(float deltaTime);
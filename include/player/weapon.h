@@ -6,53 +6,13 @@
 #include "engine/shader.h"
 #include "engine/camera.h"
 #include "engine/map.h"
+#include "player/bullet_pool.h"
+#include "engine/frame_arena.h"
 
 namespace silic2 {
 
 class EnemyManager; // forward declaration
-
-struct Bullet {
-    glm::vec3 position;
-    glm::vec3 prevPosition;  // Position last frame — used for swept collision
-    glm::vec3 velocity;
-    glm::vec3 direction;
-    float lifetime;
-    float maxLifetime;
-    float speed;
-    glm::vec3 color;
-    float intensity;
-    float length;  // Bullet length
-
-    Bullet(const glm::vec3& pos, const glm::vec3& dir, float spd = 50.0f)
-        : position(pos), prevPosition(pos), direction(glm::normalize(dir)), speed(spd),
-          lifetime(0.0f), maxLifetime(3.0f),
-          color(0.5f, 0.8f, 1.0f), intensity(2.0f), length(0.3f) {  // Sky blue color
-        velocity = direction * speed;
-    }
-
-    void update(float deltaTime) {
-        prevPosition = position;
-        position += velocity * deltaTime;
-        lifetime += deltaTime;
-    }
-    
-    bool isAlive() const {
-        return lifetime < maxLifetime;
-    }
-    
-    // Get bullet data as light source
-    glm::vec3 getLightPosition() const {
-        return position;
-    }
-    
-    glm::vec3 getLightColor() const {
-        return color * intensity;
-    }
-    
-    float getLightRange() const {
-        return 3.0f; // Light range
-    }
-};
+class ParticleSystem;
 
 // Impact light effect structure
 struct ImpactLight {
@@ -82,18 +42,28 @@ struct ImpactLight {
 
 class Weapon {
 public:
+    enum class FireMode {
+        PROJECTILE,  // Simulated bullets (default)
+        HITSCAN      // Instant ray against the map and enemies
+    };
+
     Weapon();
     ~Weapon();
     
     void init();
     void update(float deltaTime, const Map* map, EnemyManager* enemies = nullptr);
-    void render(const glm::mat4& view, const glm::mat4& projection);
+    // 'alpha' blends each bullet between its last two simulated positions
+    void render(const glm::mat4& view, const glm::mat4& projection, float alpha = 1.0f);
     
-    // Fire bullet from screen bottom-right towards center
+    // Fire bullet from screen bottom-right towards center. In HITSCAN mode the shot is a
+    // ray along the view direction, resolved at the start of the next update()
     void fire(const Camera& camera);
     
-    // Get active bullets' light source data
-    std::vector<std::pair<glm::vec3, glm::vec3>> getActiveLights() const;
+    void setFireMode(FireMode mode) { fireMode = mode; }
+    FireMode getFireMode() const { return fireMode; }
+    
+    // (position, color * intensity) of every bullet and impact light, in frame memory
+    FrameVector<std::pair<glm::vec3, glm::vec3>> getActiveLights(FrameArena& arena) const;
     
     // Get active bullet count
     size_t getActiveBulletCount() const { return bullets.size(); }
@@ -103,8 +73,26 @@ public:
     bool isBulletLightingEnabled() const { return bulletLightingEnabled; }
 
 private:
-    std::vector<Bullet> bullets;
+    BulletPool bullets;
     std::vector<ImpactLight> impactLights;
+    
+    // Per-frame collision scratch (kept to avoid per-frame allocation)
+    SegmentBatch bulletSegments;          // Swept segments sent to the enemy pass
+    std::vector<uint32_t> segmentBullets; // bulletSegments index -> bullets index
+    std::vector<uint8_t> enemyHits;
+    std::vector<uint8_t> bulletSpent;
+    std::vector<SegmentHit> bulletWallHits; // Per-bullet wall result, filled by parallel jobs
+    
+    // Hitscan shots fired since the last update, and their per-shot query scratch
+    struct HitscanShot {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+    std::vector<HitscanShot> pendingShots;
+    std::vector<SegmentHit> shotWallHits;
+    std::vector<float> shotEnemyT;
+    std::unique_ptr<ParticleSystem> impactParticles;
+    
     std::unique_ptr<Shader> bulletShader;
     std::unique_ptr<Shader> glowShader;
     
@@ -115,9 +103,10 @@ private:
     
     void setupBulletMesh();
     void setupGlowMesh();
-    void cleanupDeadBullets();
     void cleanupDeadLights();
-    bool checkBulletCollision(const Bullet& bullet, const Map* map);
+    bool checkBulletCollision(size_t bullet, const Map* map, SegmentHit& hit) const;
+    void resolveHitscanShots(const Map* map, EnemyManager* enemies);
+    void spawnImpact(const glm::vec3& point, const glm::vec3& normal);
     void createImpactLight(const glm::vec3& position, const glm::vec3& color, float intensity);
     
     // Fire cooldown
@@ -126,6 +115,18 @@ private:
     
     // Bullet lighting effects toggle
     bool bulletLightingEnabled;
+    
+    FireMode fireMode = FireMode::PROJECTILE;
+    
+    static constexpr float HITSCAN_RANGE = 100.0f;     // Matches the projectile aim distance
+    static constexpr int   IMPACT_PARTICLE_COUNT = 8;  // Sparks per hitscan impact
+    static constexpr int   IMPACT_MAX_CELL_STEPS = 4;  // Grid cells a spark burst may be pushed off a wall
+    static constexpr size_t BULLET_JOB_GRAIN = 32;     // Bullets per move + wall-test job
+
+    // Projectile rounds
+    static constexpr float BULLET_SPEED       = 65.0f;
+    static constexpr float BULLET_LIFETIME    = 3.0f;  // Seconds before a bullet that hit nothing expires
+    static constexpr float BULLET_INTENSITY   = 2.0f;
 };
 
 } // namespace silic2
\ No newline at end of file
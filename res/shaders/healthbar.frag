@@ -1,4 +1,4 @@
 #version 330 core
-uniform vec4 color;
+in vec4 vColor;
 out vec4 FragColor;
-void main() { FragColor = color; }
+void main() { FragColor = vColor; }
@@ -1,19 +1,38 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aColor;
-layout (location = 2) in float aSize;
+// One float stream each (ParticleSystem::streams order); velocity is unused here
+layout (location = 0) in float aPosX;
+layout (location = 1) in float aPosY;
+layout (location = 2) in float aPosZ;
+layout (location = 3) in float aColorR;
+layout (location = 4) in float aColorG;
+layout (location = 5) in float aColorB;
+layout (location = 6) in float aSize;
+layout (location = 10) in float aLife;
+layout (location = 11) in float aInvMaxLife;
+layout (location = 12) in float aFadeRatio;
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform bool fadeOut;
 
 out vec3 vertexColor;
 out float vertexSize;
 
 void main() {
-    gl_Position = projection * view * vec4(aPos, 1.0);
+    // Expired slots of the GPU backend: place the point outside the clip volume
+    if (aLife <= 0.0) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_PointSize = 1.0;
+        vertexColor = vec3(0.0);
+        vertexSize = 0.0;
+        return;
+    }
+
+    gl_Position = projection * view * vec4(aPosX, aPosY, aPosZ, 1.0);
     gl_PointSize = aSize * 20.0; // Scale up point size even more for visibility
     
-    vertexColor = aColor;
+    float fade = fadeOut ? pow(clamp(aLife * aInvMaxLife, 0.0, 1.0), aFadeRatio) : 1.0;
+    vertexColor = vec3(aColorR, aColorG, aColorB) * fade;
     vertexSize = aSize;
 }
\ No newline at end of file
@@ -3,25 +3,49 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 
-// Per-instance data
-layout (location = 2) in vec3 instancePos;
-layout (location = 3) in vec3 instanceColor;
-layout (location = 4) in float instanceSize;
-layout (location = 5) in vec3 instanceVelocity;
+// Per-instance data, one float stream each (ParticleSystem::streams order)
+layout (location = 2) in float instancePosX;
+layout (location = 3) in float instancePosY;
+layout (location = 4) in float instancePosZ;
+layout (location = 5) in float instanceColorR;
+layout (location = 6) in float instanceColorG;
+layout (location = 7) in float instanceColorB;
+layout (location = 8) in float instanceSize;
+layout (location = 9) in float instanceVelX;
+layout (location = 10) in float instanceVelY;
+layout (location = 11) in float instanceVelZ;
+layout (location = 12) in float instanceLife;
+layout (location = 13) in float instanceInvMaxLife;
+layout (location = 14) in float instanceFadeRatio;
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform bool fadeOut;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec3 ParticleColor;
 
 void main() {
+    // Expired slots of the GPU backend: collapse the box outside the clip volume
+    if (instanceLife <= 0.0) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        FragPos = vec3(0.0);
+        Normal = vec3(0.0);
+        ParticleColor = vec3(0.0);
+        return;
+    }
+
+    vec3 instancePos = vec3(instancePosX, instancePosY, instancePosZ);
+    vec3 instanceVelocity = vec3(instanceVelX, instanceVelY, instanceVelZ);
+
     // Scale the box based on particle size (smaller than bullets)
     vec3 scaledPos = aPos * instanceSize * 0.5; // Half the size for better proportion
     
-    // Create rotation matrix based on velocity direction
-    vec3 forward = normalize(instanceVelocity);
+    // Create rotation matrix based on velocity direction; stuck (STICK) and resting
+    // particles have none, so they fall back to an axis-aligned box instead of NaN
+    float speed = length(instanceVelocity);
+    vec3 forward = speed > 1e-4 ? instanceVelocity / speed : vec3(0.0, 0.0, -1.0);
     vec3 up = vec3(0.0, 1.0, 0.0);
     if (abs(dot(forward, up)) > 0.99) {
         up = vec3(1.0, 0.0, 0.0);
@@ -36,7 +60,8 @@ void main() {
     
     FragPos = worldPos;
     Normal = rotation * aNormal;
-    ParticleColor = instanceColor;
+    float fade = fadeOut ? pow(clamp(instanceLife * instanceInvMaxLife, 0.0, 1.0), instanceFadeRatio) : 1.0;
+    ParticleColor = vec3(instanceColorR, instanceColorG, instanceColorB) * fade;
     
     gl_Position = projection * view * vec4(worldPos, 1.0);
 }
\ No newline at end of file
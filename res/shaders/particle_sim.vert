@@ -0,0 +1,47 @@
+#version 330 core
+
+// One particle per vertex, captured by transform feedback (GpuParticleSim). Same steps
+// as integrateParticles: position by velocity, then gravity and wind, then life.
+layout (location = 0) in vec3 inPosition;
+layout (location = 1) in vec3 inColor;
+layout (location = 2) in float inSize;
+layout (location = 3) in vec3 inVelocity;
+layout (location = 4) in float inLife;
+layout (location = 5) in float inInvMaxLife;
+layout (location = 6) in float inFadeRatio;
+layout (location = 7) in float inGravity;
+
+uniform float dt;
+uniform float gravityDt;  // System gravity * dt
+uniform vec3 windDt;      // Wind acceleration * dt
+
+out vec3 outPosition;
+out vec3 outColor;
+out float outSize;
+out vec3 outVelocity;
+out float outLife;
+out float outInvMaxLife;
+out float outFadeRatio;
+out float outGravity;
+
+void main() {
+    outColor = inColor;
+    outSize = inSize;
+    outInvMaxLife = inInvMaxLife;
+    outFadeRatio = inFadeRatio;
+    outGravity = inGravity;
+
+    // Expired particles keep their state until the slot is reused
+    if (inLife <= 0.0) {
+        outPosition = inPosition;
+        outVelocity = inVelocity;
+        outLife = inLife;
+        return;
+    }
+
+    outPosition = inPosition + inVelocity * dt;
+    outVelocity = vec3(inVelocity.x + windDt.x,
+                       (inVelocity.y + gravityDt * inGravity) + windDt.y,
+                       inVelocity.z + windDt.z);
+    outLife = inLife - dt;
+}
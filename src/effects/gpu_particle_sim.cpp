@@ -0,0 +1,172 @@
+#include "effects/gpu_particle_sim.h"
+#include "engine/shader.h"
+#include "engine/profiler.h"
+#include "engine/log.h"
+#include <algorithm>
+
+namespace silic2 {
+
+GpuParticleSim::GpuParticleSim(size_t maxParticles) : capacity(maxParticles) {}
+
+GpuParticleSim::~GpuParticleSim() {
+    if (simVAOs[0]) glDeleteVertexArrays(2, simVAOs);
+    if (buffers[0]) glDeleteBuffers(2, buffers);
+}
+
+bool GpuParticleSim::init() {
+    if (initialized) return simShader != nullptr;
+    initialized = true;
+
+    try {
+        // Same layout as PARTICLE_FLOATS, so the draw shaders read the output directly
+        simShader = std::make_unique<Shader>("res/shaders/particle_sim.vert", std::vector<const char*>{
+            "outPosition", "outColor", "outSize", "outVelocity",
+            "outLife", "outInvMaxLife", "outFadeRatio", "outGravity"});
+    } catch (const std::exception& e) {
+        SILIC2_LOG_ERROR("Failed to load particle simulation shader: " << e.what());
+        simShader = nullptr;
+        return false;
+    }
+    GLint linked = 0;
+    glGetProgramiv(simShader->ID, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        simShader = nullptr;
+        return false;
+    }
+
+    // Input attributes: location, components, offset in floats
+    const GLint layout[][3] = {{0, 3, 0}, {1, 3, 3}, {2, 1, 6}, {3, 3, 7},
+                               {4, 1, 10}, {5, 1, 11}, {6, 1, 12}, {7, 1, 13}};
+    const GLsizei stride = PARTICLE_FLOATS * sizeof(float);
+
+    glGenBuffers(2, buffers);
+    glGenVertexArrays(2, simVAOs);
+    for (int i = 0; i < 2; ++i) {
+        glBindVertexArray(simVAOs[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * stride, nullptr, GL_DYNAMIC_COPY);
+        for (const auto& attribute : layout) {
+            glVertexAttribPointer(attribute[0], attribute[1], GL_FLOAT, GL_FALSE, stride,
+                                  (void*)(attribute[2] * sizeof(float)));
+            glEnableVertexAttribArray(attribute[0]);
+        }
+    }
+    glBindVertexArray(0);
+
+    SILIC2_LOG_INFO("GPU particle simulation initialized with " << capacity << " slots");
+    return true;
+}
+
+float* GpuParticleSim::queueParticles(size_t count) {
+    // Nothing flushes while the effect isn't drawn; only the newest 'capacity' particles
+    // could survive the ring anyway
+    size_t queued = pendingParticles.size() / PARTICLE_FLOATS;
+    if (queued >= 2 * capacity && queued > 0) {
+        dropOldestQueued(queued - capacity);
+        queued = capacity;
+    }
+    pendingParticles.resize((queued + count) * PARTICLE_FLOATS);
+    return pendingParticles.data() + queued * PARTICLE_FLOATS;
+}
+
+void GpuParticleSim::queueStep(const ParticleStep& step) {
+    if (pendingSteps.size() >= MAX_PENDING_STEPS) {
+        PendingStep& last = pendingSteps.back();
+        last.step.dt += step.dt;
+        last.step.gravityDt += step.gravityDt;
+        last.step.windDt += step.windDt;
+        return;
+    }
+    pendingSteps.push_back({step, pendingParticles.size() / PARTICLE_FLOATS});
+}
+
+void GpuParticleSim::dropOldestQueued(size_t count) {
+    pendingParticles.erase(pendingParticles.begin(), pendingParticles.begin() + count * PARTICLE_FLOATS);
+    for (PendingStep& pending : pendingSteps) {
+        pending.particlesBefore = pending.particlesBefore > count ? pending.particlesBefore - count : 0;
+    }
+}
+
+size_t GpuParticleSim::getParticleCount() const {
+    return std::min(capacity, slotsInUse + pendingParticles.size() / PARTICLE_FLOATS);
+}
+
+void GpuParticleSim::flush() {
+    SILIC2_PROFILE_ZONE("GpuParticleSim::flush");
+    if (simShader) {
+        // Particles join right before the first step after their emission
+        size_t uploaded = 0;
+        for (const PendingStep& pending : pendingSteps) {
+            uploadParticles(uploaded, pending.particlesBefore - uploaded);
+            uploaded = pending.particlesBefore;
+            runStep(pending.step);
+        }
+        uploadParticles(uploaded, pendingParticles.size() / PARTICLE_FLOATS - uploaded);
+    }
+    pendingParticles.clear();
+    pendingSteps.clear();
+}
+
+void GpuParticleSim::uploadParticles(size_t first, size_t count) {
+    if (count == 0 || capacity == 0) return;
+    // Within one upload, all but the newest 'capacity' would be overwritten straight away
+    if (count > capacity) {
+        first += count - capacity;
+        count = capacity;
+    }
+
+    // New particles go into the buffer the next step reads
+    const size_t particleBytes = PARTICLE_FLOATS * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+    while (count > 0) {
+        size_t run = std::min(count, capacity - ringHead);
+        glBufferSubData(GL_ARRAY_BUFFER, ringHead * particleBytes, run * particleBytes,
+                        pendingParticles.data() + first * PARTICLE_FLOATS);
+        ringHead = (ringHead + run) % capacity;
+        slotsInUse = std::min(capacity, slotsInUse + run);
+        first += run;
+        count -= run;
+    }
+}
+
+void GpuParticleSim::runStep(const ParticleStep& step) {
+    if (slotsInUse == 0) return;
+
+    simShader->use();
+    simShader->setFloat("dt", step.dt);
+    simShader->setFloat("gravityDt", step.gravityDt);
+    simShader->setVec3("windDt", step.windDt);
+
+    // Vertex stage only: read buffers[current], capture into the other one
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(simVAOs[current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers[1 - current]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(slotsInUse));
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    current = 1 - current;
+}
+
+void GpuParticleSim::packParticle(float* out, const glm::vec3& position, const glm::vec3& velocity,
+                                  const glm::vec3& color, float life, float size, float gravity, float fadeRatio) {
+    out[0] = position.x;
+    out[1] = position.y;
+    out[2] = position.z;
+    out[3] = color.r;
+    out[4] = color.g;
+    out[5] = color.b;
+    out[6] = size;
+    out[7] = velocity.x;
+    out[8] = velocity.y;
+    out[9] = velocity.z;
+    out[10] = life;
+    out[11] = life > 0.0f ? 1.0f / life : 0.0f;
+    out[12] = fadeRatio;
+    out[13] = gravity;
+}
+
+} // namespace silic2
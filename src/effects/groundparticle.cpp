@@ -13,8 +13,10 @@ std::unique_ptr<GroundParticleSystem> createEnhancedGroundParticleSystem(size_t
     if (mode == GroundParticleSystem::GParticleMode::FIRE) {
         system->setEmissionRate(50.0f);  // Particles per second for fire
         system->setFireIntensity(3.0f);  // Much brighter, more intense fire
+        system->setCollision(ParticleCollision::KILL);  // Flames stop at ceilings and walls
     } else if (mode == GroundParticleSystem::GParticleMode::DUST) {
         system->setEmissionRate(25.0f);  // A different rate for dust
+        system->setCollision(ParticleCollision::BOUNCE);  // Dust settles off surfaces
     }
 
     system->setEnabled(true);
@@ -0,0 +1,138 @@
+#include "effects/particle_kernels.h"
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SILIC2_PARTICLE_X86 1
+#include <immintrin.h>
+#else
+#define SILIC2_PARTICLE_X86 0
+#endif
+
+namespace silic2 {
+
+namespace {
+
+void integrateScalar(const ParticleStreams& s, size_t begin, size_t end, const ParticleStep& step) {
+    for (size_t i = begin; i < end; ++i) {
+        s.posX[i] += s.velX[i] * step.dt;
+        s.posY[i] += s.velY[i] * step.dt;
+        s.posZ[i] += s.velZ[i] * step.dt;
+        s.velX[i] += step.windDt.x;
+        s.velY[i] = (s.velY[i] + step.gravityDt * s.gravity[i]) + step.windDt.y;
+        s.velZ[i] += step.windDt.z;
+        s.life[i] -= step.dt;
+    }
+}
+
+#if SILIC2_PARTICLE_X86
+
+// 4 lanes at a time; the target attribute only matters for 32-bit builds
+__attribute__((target("sse2")))
+void integrateSse2(const ParticleStreams& s, size_t begin, size_t end, const ParticleStep& step) {
+    const __m128 dt = _mm_set1_ps(step.dt);
+    const __m128 gravityDt = _mm_set1_ps(step.gravityDt);
+    const __m128 windX = _mm_set1_ps(step.windDt.x);
+    const __m128 windY = _mm_set1_ps(step.windDt.y);
+    const __m128 windZ = _mm_set1_ps(step.windDt.z);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_loadu_ps(s.velX + i);
+        __m128 vy = _mm_loadu_ps(s.velY + i);
+        __m128 vz = _mm_loadu_ps(s.velZ + i);
+        _mm_storeu_ps(s.posX + i, _mm_add_ps(_mm_loadu_ps(s.posX + i), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(s.posY + i, _mm_add_ps(_mm_loadu_ps(s.posY + i), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(s.posZ + i, _mm_add_ps(_mm_loadu_ps(s.posZ + i), _mm_mul_ps(vz, dt)));
+
+        __m128 fall = _mm_mul_ps(gravityDt, _mm_loadu_ps(s.gravity + i));
+        _mm_storeu_ps(s.velX + i, _mm_add_ps(vx, windX));
+        _mm_storeu_ps(s.velY + i, _mm_add_ps(_mm_add_ps(vy, fall), windY));
+        _mm_storeu_ps(s.velZ + i, _mm_add_ps(vz, windZ));
+        _mm_storeu_ps(s.life + i, _mm_sub_ps(_mm_loadu_ps(s.life + i), dt));
+    }
+    integrateScalar(s, i, end, step);
+}
+
+// Same as the SSE2 kernel, 8 lanes at a time
+__attribute__((target("avx2")))
+void integrateAvx2(const ParticleStreams& s, size_t begin, size_t end, const ParticleStep& step) {
+    const __m256 dt = _mm256_set1_ps(step.dt);
+    const __m256 gravityDt = _mm256_set1_ps(step.gravityDt);
+    const __m256 windX = _mm256_set1_ps(step.windDt.x);
+    const __m256 windY = _mm256_set1_ps(step.windDt.y);
+    const __m256 windZ = _mm256_set1_ps(step.windDt.z);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 vx = _mm256_loadu_ps(s.velX + i);
+        __m256 vy = _mm256_loadu_ps(s.velY + i);
+        __m256 vz = _mm256_loadu_ps(s.velZ + i);
+        _mm256_storeu_ps(s.posX + i, _mm256_add_ps(_mm256_loadu_ps(s.posX + i), _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(s.posY + i, _mm256_add_ps(_mm256_loadu_ps(s.posY + i), _mm256_mul_ps(vy, dt)));
+        _mm256_storeu_ps(s.posZ + i, _mm256_add_ps(_mm256_loadu_ps(s.posZ + i), _mm256_mul_ps(vz, dt)));
+
+        __m256 fall = _mm256_mul_ps(gravityDt, _mm256_loadu_ps(s.gravity + i));
+        _mm256_storeu_ps(s.velX + i, _mm256_add_ps(vx, windX));
+        _mm256_storeu_ps(s.velY + i, _mm256_add_ps(_mm256_add_ps(vy, fall), windY));
+        _mm256_storeu_ps(s.velZ + i, _mm256_add_ps(vz, windZ));
+        _mm256_storeu_ps(s.life + i, _mm256_sub_ps(_mm256_loadu_ps(s.life + i), dt));
+    }
+    integrateSse2(s, i, end, step);
+}
+
+#endif
+
+ParticleKernel bestKernel() {
+#if SILIC2_PARTICLE_X86
+    if (__builtin_cpu_supports("avx2")) return ParticleKernel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return ParticleKernel::SSE2;
+#endif
+    return ParticleKernel::SCALAR;
+}
+
+std::atomic<ParticleKernel>& activeKernel() {
+    static std::atomic<ParticleKernel> kernel{bestKernel()};
+    return kernel;
+}
+
+} // namespace
+
+void integrateParticles(const ParticleStreams& streams, size_t begin, size_t end, const ParticleStep& step) {
+    switch (activeKernel().load(std::memory_order_relaxed)) {
+#if SILIC2_PARTICLE_X86
+        case ParticleKernel::AVX2: integrateAvx2(streams, begin, end, step); return;
+        case ParticleKernel::SSE2: integrateSse2(streams, begin, end, step); return;
+#endif
+        default: integrateScalar(streams, begin, end, step); return;
+    }
+}
+
+ParticleKernel getParticleKernel() {
+    return activeKernel().load(std::memory_order_relaxed);
+}
+
+void setParticleKernel(ParticleKernel kernel) {
+    activeKernel().store(isParticleKernelSupported(kernel) ? kernel : bestKernel(), std::memory_order_relaxed);
+}
+
+bool isParticleKernelSupported(ParticleKernel kernel) {
+    switch (kernel) {
+        case ParticleKernel::SCALAR: return true;
+#if SILIC2_PARTICLE_X86
+        case ParticleKernel::SSE2:   return __builtin_cpu_supports("sse2");
+        case ParticleKernel::AVX2:   return __builtin_cpu_supports("avx2");
+#endif
+        default:                     return false;
+    }
+}
+
+const char* particleKernelName(ParticleKernel kernel) {
+    switch (kernel) {
+        case ParticleKernel::SCALAR: return "scalar";
+        case ParticleKernel::SSE2:   return "sse2";
+        case ParticleKernel::AVX2:   return "avx2";
+    }
+    return "?";
+}
+
+} // namespace silic2
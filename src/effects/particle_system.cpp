@@ -1,79 +1,90 @@
 #include "effects/particle_system.h"
+#include "effects/particle_kernels.h"
+#include "effects/gpu_particle_sim.h"
 #include "engine/shader.h"
+#include "engine/job_system.h"
+#include "engine/profiler.h"
+#include "engine/log.h"
+#include "engine/stream_buffer.h"
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <random>
-#include <iostream>
 
 namespace silic2 {
 
-// Random number generator for particle effects
-static std::random_device rd;
-static std::mt19937 gen(rd());
-static std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
-static std::uniform_real_distribution<float> dis01(0.0f, 1.0f);
-
-float randomFloat(float min, float max) {
-    std::uniform_real_distribution<float> distribution(min, max);
-    return distribution(gen);
+namespace {
+// Shared seed of every particle stream; streams reseed when the generation changes
+std::atomic<uint32_t> particleSeed{std::random_device{}()};
+std::atomic<uint32_t> particleSeedGeneration{0};
+
+// Counter-based random in [min, max): the same (seed, counter) always gives the same
+// value, whichever thread asks and in whatever order
+float hashedRange(uint32_t seed, uint32_t counter, float min, float max) {
+    uint32_t h = seed ^ (counter * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return min + (max - min) * (static_cast<float>(h >> 8) * (1.0f / 16777216.0f));
 }
+} // namespace
 
-glm::vec3 randomVec3(float min, float max) {
-    return glm::vec3(
-        randomFloat(min, max),
-        randomFloat(min, max),
-        randomFloat(min, max)
-    );
+void seedParticleRandom(uint32_t seed) {
+    particleSeed.store(seed, std::memory_order_relaxed);
+    particleSeedGeneration.fetch_add(1, std::memory_order_release);
 }
 
-//building a lookup table for fade values for better runtime
-const std::vector<float>& ParticleSystem::getFadeLUT(float fadeRatio) {
-    // Check if LUT for this fadeRatio exists
-    auto it = fadeLUTCache.find(fadeRatio);
-    if (it != fadeLUTCache.end()) {
-        return it->second;
-    }
+void ParticleRandom::reseedIfStale() {
+    uint32_t generation = particleSeedGeneration.load(std::memory_order_acquire);
+    if (generation == seedGeneration) return;
+    std::seed_seq sequence{particleSeed.load(std::memory_order_relaxed), streamId};
+    engine.seed(sequence);
+    seedGeneration = generation;
+}
 
-    // Build new LUT
-    std::vector<float> newLUT(fadeOutSmoothness + 1);
-    for (int i = 0; i <= fadeOutSmoothness; ++i) {
-        float r = static_cast<float>(i) / fadeOutSmoothness;
-        newLUT[i] = std::pow(r, fadeRatio);
-    }
+float ParticleRandom::range(float min, float max) {
+    reseedIfStale();
+    std::uniform_real_distribution<float> distribution(min, max);
+    return distribution(engine);
+}
 
-    // Store in cache and return
-    fadeLUTCache[fadeRatio] = std::move(newLUT);
-    return fadeLUTCache[fadeRatio];
+uint32_t ParticleRandom::next() {
+    reseedIfStale();
+    return static_cast<uint32_t>(engine());
 }
 
 // ParticleSystem Implementation
-ParticleSystem::ParticleSystem(size_t maxParticles)
-    : maxParticleCount(maxParticles), nextDeadParticle(0), 
-      VAO(0), VBO(0), boxVAO(0), boxVBO(0), instanceVBO(0) {
-    particles.resize(maxParticleCount);
+ParticleSystem::ParticleSystem(size_t maxParticles, ParticleStream stream)
+    : maxParticleCount(0), random(stream),
+      VAO(0), boxVAO(0), boxVBO(0), gpuVAO(0), gpuBoxVAO(0) {
+    // Full capacity up front: only the GROW policy reallocates the streams
+    resizeStreams(maxParticles);
     // Delay initialization until first render call
 }
 
 ParticleSystem::~ParticleSystem() {
     if (VAO) glDeleteVertexArrays(1, &VAO);
-    if (VBO) glDeleteBuffers(1, &VBO);
     if (boxVAO) glDeleteVertexArrays(1, &boxVAO);
     if (boxVBO) glDeleteBuffers(1, &boxVBO);
-    if (instanceVBO) glDeleteBuffers(1, &instanceVBO);
+    if (gpuVAO) glDeleteVertexArrays(1, &gpuVAO);
+    if (gpuBoxVAO) glDeleteVertexArrays(1, &gpuBoxVAO);
 }
 
 void ParticleSystem::initRenderingResources() {
-    std::cout << "Initializing particle system rendering resources..." << std::endl;
+    SILIC2_LOG_INFO("Initializing particle system rendering resources...");
     
     // Create shaders
     try {
         particleShader = std::make_unique<Shader>("res/shaders/particle.vert", "res/shaders/particle.frag");
-        std::cout << "Particle shaders loaded successfully" << std::endl;
+        SILIC2_LOG_INFO("Particle shaders loaded successfully");
         
         // Load 3D box shader
         boxShader = std::make_unique<Shader>("res/shaders/particle_box.vert", "res/shaders/particle_box.frag");
-        std::cout << "Particle box shaders loaded successfully" << std::endl;
+        SILIC2_LOG_INFO("Particle box shaders loaded successfully");
     } catch (const std::exception& e) {
-        std::cerr << "Failed to load particle shaders: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Failed to load particle shaders: " << e.what());
         // Don't return, continue without rendering
         particleShader = nullptr;
         boxShader = nullptr;
@@ -82,32 +93,17 @@ void ParticleSystem::initRenderingResources() {
     
     // Generate OpenGL objects for point sprites
     glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
+    glGenVertexArrays(1, &gpuVAO);
     
-    if (VAO == 0 || VBO == 0) {
-        std::cerr << "Failed to generate OpenGL objects for particle system" << std::endl;
+    if (VAO == 0 || gpuVAO == 0) {
+        SILIC2_LOG_ERROR("Failed to generate OpenGL objects for particle system");
         return;
     }
     
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    
-    // Vertex layout: position (3) + color (3) + size (1) = 7 floats per particle
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(6 * sizeof(float)));
-
-    
-    glBindVertexArray(0);
-    
-    // Setup 3D box mesh
+    // Setup 3D box mesh. The stream attributes are bound once there is a buffer to read.
     setupBoxMesh();
     
-    std::cout << "Particle system initialized with " << maxParticleCount << " max particles" << std::endl;
+    SILIC2_LOG_INFO("Particle system initialized with " << maxParticleCount << " max particles");
 }
 
 void ParticleSystem::setupBoxMesh() {
@@ -165,15 +161,21 @@ void ParticleSystem::setupBoxMesh() {
     
     // Generate VAO and VBO for box mesh
     glGenVertexArrays(1, &boxVAO);
+    glGenVertexArrays(1, &gpuBoxVAO);
     glGenBuffers(1, &boxVBO);
-    glGenBuffers(1, &instanceVBO);
-    
-    glBindVertexArray(boxVAO);
     
     // Box mesh data
     glBindBuffer(GL_ARRAY_BUFFER, boxVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(boxVertices), boxVertices, GL_STATIC_DRAW);
     
+    bindBoxMesh(boxVAO);
+    bindBoxMesh(gpuBoxVAO);
+}
+
+void ParticleSystem::bindBoxMesh(GLuint vao) {
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, boxVBO);
+    
     // Vertex positions
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -182,85 +184,140 @@ void ParticleSystem::setupBoxMesh() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    // Instance data buffer
-    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-    
-    // Instance position
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(2);
-    glVertexAttribDivisor(2, 1);
-    
-    // Instance color
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-    glVertexAttribDivisor(3, 1);
-    
-    // Instance size
-    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(4);
-    glVertexAttribDivisor(4, 1);
-    
-    // Instance velocity (for rotation)
-    glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void*)(7 * sizeof(float)));
-    glEnableVertexAttribArray(5);
-    glVertexAttribDivisor(5, 1);
-    
     glBindVertexArray(0);
 }
 
+void ParticleSystem::bindStreamAttributes(GLuint vao, GLuint buffer, GLuint firstLocation, GLuint divisor,
+                                          size_t baseOffset, size_t streamOffset, GLsizei stride) {
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (size_t k = 0; k < RENDER_STREAMS; ++k) {
+        GLuint location = firstLocation + static_cast<GLuint>(k);
+        glVertexAttribPointer(location, 1, GL_FLOAT, GL_FALSE, stride, (void*)(baseOffset + k * streamOffset));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, divisor);
+    }
+    glBindVertexArray(0);
+}
+
+bool ParticleSystem::uploadStreams(bool boxes) {
+    // One section of liveCount floats per render stream, in this frame's stream buffer region
+    const size_t section = liveCount * sizeof(float);
+    StreamBuffer& streamBuffer = StreamBuffer::getInstance();
+    StreamSlice slice = streamBuffer.map(RENDER_STREAMS * section);
+    if (!slice.data) return false;
+
+    // The live range of each stream is contiguous: one copy per stream, no repacking
+    auto all = streams();
+    char* out = static_cast<char*>(slice.data);
+    for (size_t k = 0; k < RENDER_STREAMS; ++k) {
+        std::memcpy(out + k * section, all[k]->data(), section);
+    }
+    streamBuffer.unmap();
+
+    // The slice moves every frame, so the attributes follow it. Point sprites read the
+    // streams per vertex, boxes per instance.
+    if (boxes) {
+        bindStreamAttributes(boxVAO, slice.buffer, 2, 1, slice.offset, section, sizeof(float));
+    } else {
+        bindStreamAttributes(VAO, slice.buffer, 0, 0, slice.offset, section, sizeof(float));
+    }
+    return true;
+}
+
 void ParticleSystem::update(float deltaTime) {
-    
-    for (auto& particle : particles) {
-        if (!particle.isAlive()) continue;
-        
-        // Update physics
-        particle.pPosition += particle.pVelocity * deltaTime;
-        particle.pVelocity.y += defaultGravity * particle.pGravity * deltaTime;
-        particle.pVelocity += windForce * deltaTime;
-        
-        // Update life
-        particle.pLife -= deltaTime;
-        
-        
-        // Fade out color based on life if enabled
-        if (fadeOutEnabled && particle.pMaxLife > 0.0f) {
-            float invMaxLife = 1.0f / particle.pMaxLife;
-            float lifeRatio  = particle.pLife * invMaxLife;
-            float nextRatio  = (particle.pLife - deltaTime) * invMaxLife;
-
-            float fadeRatio = particle.pFadeRatio;
-
-            // Build LUT if fadeRatio changed
-            if (fadeRatio != lastFadeRatio || fadeLUTCache.empty()) {
-                getFadeLUT(fadeRatio);
-                lastFadeRatio = fadeRatio;
-            }
-            auto fadeLUTIt = fadeLUTCache.find(fadeRatio);
-            const auto& fadeLUT = fadeLUTIt->second;
+    SILIC2_PROFILE_ZONE("ParticleSystem::update");
+    ParticleStreams streams = {posX.data(), posY.data(), posZ.data(),
+                               velX.data(), velY.data(), velZ.data(),
+                               life.data(), gravity.data()};
+    ParticleStep step = {deltaTime, defaultGravity * deltaTime, windForce * deltaTime};
+    if (backend == ParticleBackend::GPU) {
+        gpuSim->queueStep(step);    // Runs on the GL thread in render()
+        return;
+    }
 
-            // Clamp & lookup
-            int idxCurr = std::max(0, std::min(fadeOutSmoothness, int(lifeRatio  * fadeOutSmoothness)));
-            int idxNext = std::max(0, std::min(fadeOutSmoothness, int(nextRatio * fadeOutSmoothness)));
+    // Particles are independent; each job integrates its own range with the SIMD kernel,
+    // after deciding from the velocity whether this step runs into geometry
+    bool collide = collisionResponse != ParticleCollision::NONE && collisionGrid && !collisionGrid->empty();
+    JobSystem::getInstance().parallelFor(liveCount, UPDATE_JOB_GRAIN, [&](size_t begin, size_t end) {
+        if (collide) collideParticles(begin, end, deltaTime);
+        integrateParticles(streams, begin, end, step);
+    });
+    removeDeadParticles();
+}
 
-            particle.pColor *= fadeLUT[idxNext] / fadeLUT[idxCurr];
-            
+void ParticleSystem::collideParticles(size_t begin, size_t end, float deltaTime) {
+    const OccupancyGrid& grid = *collisionGrid;
+    for (size_t i = begin; i < end; ++i) {
+        glm::vec3 from(posX[i], posY[i], posZ[i]);
+        glm::vec3 velocity(velX[i], velY[i], velZ[i]);
+        glm::vec3 to = from + velocity * deltaTime;
+        if (!grid.isSolid(to) || grid.isSolid(from)) continue;
+
+        switch (collisionResponse) {
+            case ParticleCollision::KILL:
+                life[i] = 0.0f;     // Removed after this step
+                break;
+            case ParticleCollision::BOUNCE: {
+                // Reflect each axis whose move alone would enter geometry; a corner hit reflects all
+                bool reflected = false;
+                for (int axis = 0; axis < 3; ++axis) {
+                    glm::vec3 probe = from;
+                    probe[axis] = to[axis];
+                    if (grid.isSolid(probe)) {
+                        velocity[axis] = -velocity[axis] * restitution;
+                        reflected = true;
+                    }
+                }
+                if (!reflected) velocity = -velocity * restitution;
+                velX[i] = velocity.x;
+                velY[i] = velocity.y;
+                velZ[i] = velocity.z;
+                break;
+            }
+            case ParticleCollision::STICK:
+                velX[i] = velY[i] = velZ[i] = 0.0f;
+                gravity[i] = 0.0f;
+                break;
+            case ParticleCollision::NONE:
+                break;
         }
-            
     }
 }
 
 void ParticleSystem::render(const glm::mat4& view, const glm::mat4& projection) {
+    SILIC2_PROFILE_ZONE("ParticleSystem::render");
     // Initialize on first render call
-    if (!particleShader && VAO == 0 && VBO == 0) {
+    if (!particleShader && VAO == 0) {
         initRenderingResources();
     }
     
-    if (use3DBoxes && boxShader && boxVAO != 0) {
+    bool drawBoxes = use3DBoxes && boxShader && boxVAO != 0;
+    bool drawPoints = !drawBoxes && particleShader && VAO != 0;
+    if (!drawBoxes && !drawPoints) return;
+    
+    // Both backends feed the same shaders; only the buffer layout differs
+    size_t drawCount = 0;
+    GLuint drawBoxVAO = boxVAO;
+    GLuint drawPointVAO = VAO;
+    if (backend == ParticleBackend::GPU) {
+        if (!gpuSim->init()) return;
+        gpuSim->flush();
+        drawCount = gpuSim->getSlotsInUse();
+        drawBoxVAO = gpuBoxVAO;
+        drawPointVAO = gpuVAO;
+        // Ping-pong: the latest state is in a different buffer after every step
+        const size_t stride = GpuParticleSim::PARTICLE_FLOATS * sizeof(float);
+        GLuint state = gpuSim->getStateBuffer();
+        bindStreamAttributes(drawBoxes ? gpuBoxVAO : gpuVAO, state, drawBoxes ? 2 : 0, drawBoxes ? 1 : 0,
+                             0, sizeof(float), static_cast<GLsizei>(stride));
+    } else if (liveCount > 0 && uploadStreams(drawBoxes)) {
+        drawCount = liveCount;
+    }
+    if (drawCount == 0) return;
+    
+    if (drawBoxes) {
         // Render using 3D boxes
-        updateInstanceBuffer();
-        
-        if (instanceData.empty()) return;
-        
         // Calculate view position for rim lighting
         glm::mat4 invView = glm::inverse(view);
         glm::vec3 viewPos = glm::vec3(invView[3]);
@@ -269,36 +326,27 @@ void ParticleSystem::render(const glm::mat4& view, const glm::mat4& projection)
         boxShader->setMat4("view", view);
         boxShader->setMat4("projection", projection);
         boxShader->setVec3("viewPos", viewPos);
-        
-        // Update instance buffer
-        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-        glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(float), instanceData.data(), GL_DYNAMIC_DRAW);
+        boxShader->setBool("fadeOut", fadeOutEnabled);
         
         // Enable blending for glowing effect
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE);  // Additive blending
         
         // Render instanced boxes
-        glBindVertexArray(boxVAO);
-        size_t instanceCount = instanceData.size() / 10;  // 10 floats per instance
-        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, static_cast<GLsizei>(instanceCount));
+        glBindVertexArray(drawBoxVAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, static_cast<GLsizei>(drawCount));
         
         glBindVertexArray(0);
         glDisable(GL_BLEND);
         
-    } else if (particleShader && VAO != 0) {
+    } else {
         // Fallback to point sprites
-        updateVertexBuffer();
-        
-        if (vertexData.empty()) return;
-        
         particleShader->use();
         particleShader->setMat4("view", view);
         particleShader->setMat4("projection", projection);
+        particleShader->setBool("fadeOut", fadeOutEnabled);
         
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_DYNAMIC_DRAW);
+        glBindVertexArray(drawPointVAO);
         
         // Enable blending for particles
         glEnable(GL_BLEND);
@@ -307,7 +355,7 @@ void ParticleSystem::render(const glm::mat4& view, const glm::mat4& projection)
         // Disable depth writing but keep depth testing
         glDepthMask(GL_FALSE);
         
-        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertexData.size() / 7));
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(drawCount));
         
         // Restore depth writing
         glDepthMask(GL_TRUE);
@@ -317,123 +365,214 @@ void ParticleSystem::render(const glm::mat4& view, const glm::mat4& projection)
     }
 }
 
+void ParticleSystem::setBackend(ParticleBackend newBackend) {
+    if (newBackend == backend) return;
+    backend = newBackend;
+    liveCount = 0;
+    oldestParticle = NO_PARTICLE;
+    newestParticle = NO_PARTICLE;
+
+    size_t capacity = maxParticleCount;
+    if (backend == ParticleBackend::GPU) {
+        // State lives on the GPU; free the CPU streams (capacity can be in the millions)
+        gpuSim = std::make_unique<GpuParticleSim>(capacity);
+        for (auto* stream : streams()) {
+            std::vector<float>().swap(*stream);
+        }
+        std::vector<uint32_t>().swap(olderLink);
+        std::vector<uint32_t>().swap(newerLink);
+        std::vector<uint32_t>().swap(burstSlots);
+    } else {
+        gpuSim.reset();
+        resizeStreams(capacity);
+    }
+}
+
+size_t ParticleSystem::getActiveParticles() const {
+    return backend == ParticleBackend::GPU ? gpuSim->getParticleCount() : liveCount;
+}
+
 void ParticleSystem::emit(const glm::vec3& position, const glm::vec3& velocity, 
                          const glm::vec3& color, float life, float size, float pgravity, float fadeRatio) {
-    size_t deadIndex = findDeadParticle();
-    if (deadIndex >= particles.size()) return;
-    
-    Particle& p = particles[deadIndex];
-    p.pPosition = position;
-    p.pVelocity = velocity;
-    p.pColor = color;
-    p.pLife = life;
-    p.pMaxLife = life;
-    p.pSize = size;
-    p.pGravity = pgravity;
-    p.pFadeRatio = fadeRatio;
+    if (backend == ParticleBackend::GPU) {
+        GpuParticleSim::packParticle(gpuSim->queueParticles(1), position, velocity, color, life, size,
+                                     pgravity, fadeRatio);
+        return;
+    }
+    size_t i = allocateParticle();
+    if (i == NO_PARTICLE) return;
+    writeParticle(i, position, velocity, color, life, size, pgravity, fadeRatio);
 }
 
 void ParticleSystem::emitBurst(const glm::vec3& position, int count, 
                               const glm::vec3& baseVelocity, const glm::vec3& velocityVariation,
                               const glm::vec3& color, float life, float size, float pgravity, float fadeRatio) {
-    for (int i = 0; i < count; ++i) {
-        glm::vec3 vel = baseVelocity + glm::vec3(
-            randomFloat(-velocityVariation.x, velocityVariation.x),
-            randomFloat(-velocityVariation.y, velocityVariation.y),
-            randomFloat(-velocityVariation.z, velocityVariation.z)
-        );
-        
-        glm::vec3 particleColor = color;
-        // Add some color variation
-        particleColor.r += randomFloat(-0.1f, 0.1f);
-        particleColor.g += randomFloat(-0.1f, 0.1f);
-        particleColor.b += randomFloat(-0.1f, 0.1f);
-        particleColor = glm::clamp(particleColor, 0.0f, 1.0f);
-        
-        emit(position, vel, particleColor, life, size, pgravity, fadeRatio);
+    if (count <= 0) return;
+    size_t wanted = static_cast<size_t>(count);
+
+    // GPU backend: the burst goes straight into the upload queue
+    float* gpuOut = backend == ParticleBackend::GPU ? gpuSim->queueParticles(wanted) : nullptr;
+    size_t burstCount = wanted;
+
+    // Grow once for the whole burst rather than doubling part way through
+    if (!gpuOut && overflowPolicy == ParticleOverflow::GROW && liveCount + wanted > maxParticleCount) {
+        resizeStreams(std::max(liveCount + wanted, maxParticleCount * 2));
+    }
+    // Recycling more than the capacity would hand out a slot twice
+    if (!gpuOut && overflowPolicy == ParticleOverflow::RECYCLE_OLDEST && wanted > maxParticleCount) {
+        droppedCount += wanted - maxParticleCount;
+        wanted = maxParticleCount;
     }
-}
 
-size_t ParticleSystem::getActiveParticles() const {
-    size_t count = 0;
-    for (const auto& particle : particles) {
-        if (particle.isAlive()) count++;
+    // Take the slots serially (overflow handling is order-dependent), fill them in parallel
+    if (!gpuOut) {
+        burstSlots.clear();
+        for (size_t n = 0; n < wanted; ++n) {
+            size_t index = allocateParticle();
+            if (index == NO_PARTICLE) {
+                droppedCount += wanted - n - 1;   // allocateParticle counted this one
+                break;
+            }
+            burstSlots.push_back(static_cast<uint32_t>(index));
+        }
+        burstCount = burstSlots.size();
     }
-    return count;
+
+    uint32_t seed = random.next();
+    JobSystem::getInstance().parallelFor(burstCount, EMIT_JOB_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            uint32_t counter = static_cast<uint32_t>(n) * 6;
+            glm::vec3 vel = baseVelocity + glm::vec3(
+                hashedRange(seed, counter + 0, -velocityVariation.x, velocityVariation.x),
+                hashedRange(seed, counter + 1, -velocityVariation.y, velocityVariation.y),
+                hashedRange(seed, counter + 2, -velocityVariation.z, velocityVariation.z)
+            );
+
+            glm::vec3 particleColor = color;
+            // Add some color variation
+            particleColor.r += hashedRange(seed, counter + 3, -0.1f, 0.1f);
+            particleColor.g += hashedRange(seed, counter + 4, -0.1f, 0.1f);
+            particleColor.b += hashedRange(seed, counter + 5, -0.1f, 0.1f);
+            particleColor = glm::clamp(particleColor, 0.0f, 1.0f);
+
+            if (gpuOut) {
+                GpuParticleSim::packParticle(gpuOut + n * GpuParticleSim::PARTICLE_FLOATS, position, vel,
+                                             particleColor, life, size, pgravity, fadeRatio);
+            } else {
+                writeParticle(burstSlots[n], position, vel, particleColor, life, size, pgravity, fadeRatio);
+            }
+        }
+    });
 }
 
-void ParticleSystem::updateVertexBuffer() {
-    vertexData.clear();
-    
-    for (const auto& particle : particles) {
-        if (!particle.isAlive()) continue;
-        
-        // Position
-        vertexData.push_back(particle.pPosition.x);
-        vertexData.push_back(particle.pPosition.y);
-        vertexData.push_back(particle.pPosition.z);
-        
-        // Color
-        vertexData.push_back(particle.pColor.r);
-        vertexData.push_back(particle.pColor.g);
-        vertexData.push_back(particle.pColor.b);
-        
-        // Size
-        vertexData.push_back(particle.pSize);
-    }
+void ParticleSystem::writeParticle(size_t i, const glm::vec3& position, const glm::vec3& velocity,
+                                   const glm::vec3& color, float life, float size, float pgravity, float fadeRatio) {
+    posX[i] = position.x;
+    posY[i] = position.y;
+    posZ[i] = position.z;
+    velX[i] = velocity.x;
+    velY[i] = velocity.y;
+    velZ[i] = velocity.z;
+    colorR[i] = color.r;
+    colorG[i] = color.g;
+    colorB[i] = color.b;
+    this->life[i] = life;
+    invMaxLife[i] = life > 0.0f ? 1.0f / life : 0.0f;
+    this->size[i] = size;
+    gravity[i] = pgravity;
+    this->fadeRatio[i] = fadeRatio;
 }
 
-void ParticleSystem::updateInstanceBuffer() {
-    instanceData.clear();
-    
-    for (const auto& particle : particles) {
-        if (!particle.isAlive()) continue;
-        
-        // Position (3 floats)
-        instanceData.push_back(particle.pPosition.x);
-        instanceData.push_back(particle.pPosition.y);
-        instanceData.push_back(particle.pPosition.z);
-        
-        // Color (3 floats)
-        instanceData.push_back(particle.pColor.r);
-        instanceData.push_back(particle.pColor.g);
-        instanceData.push_back(particle.pColor.b);
-        
-        // Size (1 float)
-        instanceData.push_back(particle.pSize);
-        
-        // Velocity (3 floats) - used for rotation
-        instanceData.push_back(particle.pVelocity.x);
-        instanceData.push_back(particle.pVelocity.y);
-        instanceData.push_back(particle.pVelocity.z);
+std::array<std::vector<float>*, ParticleSystem::STREAM_COUNT> ParticleSystem::streams() {
+    return {&posX, &posY, &posZ, &colorR, &colorG, &colorB, &size, &velX, &velY, &velZ,
+            &life, &invMaxLife, &fadeRatio, &gravity};
+}
+
+void ParticleSystem::resizeStreams(size_t capacity) {
+    for (auto* stream : streams()) {
+        stream->resize(capacity);
     }
+    olderLink.resize(capacity);
+    newerLink.resize(capacity);
+    burstSlots.reserve(capacity);
+    maxParticleCount = capacity;
 }
 
-size_t ParticleSystem::findDeadParticle() {
-    // Start from the last known dead particle for efficiency
-    for (size_t i = nextDeadParticle; i < particles.size(); ++i) {
-        if (!particles[i].isAlive()) {
-            nextDeadParticle = i + 1;
-            return i;
+size_t ParticleSystem::allocateParticle() {
+    if (liveCount == maxParticleCount) {
+        switch (overflowPolicy) {
+            case ParticleOverflow::DROP_NEW:
+                break;
+            case ParticleOverflow::RECYCLE_OLDEST:
+                if (oldestParticle != NO_PARTICLE) {
+                    // Reuse it in place; it becomes the newest
+                    size_t index = oldestParticle;
+                    unlink(index);
+                    linkNewest(index);
+                    return index;
+                }
+                break;
+            case ParticleOverflow::GROW:
+                resizeStreams(std::max<size_t>(maxParticleCount * 2, 64));
+                break;
         }
-    }
-    
-    // Search from the beginning
-    for (size_t i = 0; i < nextDeadParticle; ++i) {
-        if (!particles[i].isAlive()) {
-            nextDeadParticle = i + 1;
-            return i;
+        if (liveCount == maxParticleCount) {
+            ++droppedCount;
+            return NO_PARTICLE;
         }
     }
-    
-    // No dead particles found
-    nextDeadParticle = 0;
-    return particles.size();
+
+    size_t index = liveCount++;
+    linkNewest(index);
+    return index;
+}
+
+void ParticleSystem::moveParticle(size_t from, size_t to) {
+    for (auto* stream : streams()) {
+        (*stream)[to] = (*stream)[from];
+    }
+
+    // Take over its place in the emission order
+    uint32_t older = olderLink[from];
+    uint32_t newer = newerLink[from];
+    olderLink[to] = older;
+    newerLink[to] = newer;
+    if (older != NO_PARTICLE) newerLink[older] = static_cast<uint32_t>(to);
+    else oldestParticle = static_cast<uint32_t>(to);
+    if (newer != NO_PARTICLE) olderLink[newer] = static_cast<uint32_t>(to);
+    else newestParticle = static_cast<uint32_t>(to);
+}
+
+void ParticleSystem::linkNewest(size_t index) {
+    olderLink[index] = newestParticle;
+    newerLink[index] = NO_PARTICLE;
+    if (newestParticle != NO_PARTICLE) newerLink[newestParticle] = static_cast<uint32_t>(index);
+    else oldestParticle = static_cast<uint32_t>(index);
+    newestParticle = static_cast<uint32_t>(index);
+}
+
+void ParticleSystem::unlink(size_t index) {
+    uint32_t older = olderLink[index];
+    uint32_t newer = newerLink[index];
+    if (older != NO_PARTICLE) newerLink[older] = newer;
+    else oldestParticle = newer;
+    if (newer != NO_PARTICLE) olderLink[newer] = older;
+    else newestParticle = older;
+}
+
+void ParticleSystem::removeDeadParticles() {
+    // Walk backwards so the particle swapped into a hole has already been checked
+    for (size_t i = liveCount; i-- > 0;) {
+        if (life[i] > 0.0f) continue;
+        unlink(i);
+        size_t last = --liveCount;
+        if (i != last) moveParticle(last, i);
+    }
 }
 
 // GroundParticleSystem Implementation
 GroundParticleSystem::GroundParticleSystem(size_t maxParticles) {
-    particleSystem = std::make_unique<ParticleSystem>(maxParticles);
+    particleSystem = std::make_unique<ParticleSystem>(maxParticles, ParticleStream::GROUND);
     particleSystem->setGravity(-0.2f);  // Very light gravity to reach ceiling
     particleSystem->setFadeOut(true);
 }
@@ -442,8 +581,9 @@ GroundParticleSystem::~GroundParticleSystem() = default;
 
 void GroundParticleSystem::initialize(const Map& map) {
     extractFloorPositions(map);
-    std::cout << "Ground particle system initialized with " << floorPositions.size() 
-              << " floor spawn points" << std::endl;
+    particleSystem->setCollisionGrid(&map.getOccupancyGrid());
+    SILIC2_LOG_INFO("Ground particle system initialized with " << floorPositions.size() 
+              << " floor spawn points");
 }
 
 void GroundParticleSystem::update(float deltaTime) {
@@ -451,6 +591,7 @@ void GroundParticleSystem::update(float deltaTime) {
         particleSystem->update(deltaTime);
         return;
     }
+    ParticleRandom& random = particleSystem->getRandom();
     
     // Update emission timer
     emissionTimer += deltaTime;
@@ -476,20 +617,20 @@ void GroundParticleSystem::update(float deltaTime) {
         glm::vec3 pspawnPos = getRandomFloorPosition();
                 
         // Add slight randomness to position 
-        pspawnPos.x += randomFloat(-0.5f, 0.5f);
-        pspawnPos.z += randomFloat(-0.5f, 0.5f);
+        pspawnPos.x += random.range(-0.5f, 0.5f);
+        pspawnPos.z += random.range(-0.5f, 0.5f);
         pspawnPos.y += config.particleSpawnHeight;
                 
         // Calculate fire velocity (upward with high variation for different heights)
         glm::vec3 pvelocity = glm::vec3(
-            randomFloat(-0.5f, 0.5f),  // Horizontal drift
-            config.baseVelocity + randomFloat(-1.0 * config.velocityVariation, config.velocityVariation),  // Much more speed variation for height differences
-            randomFloat(-0.5f, 0.5f)
+            random.range(-0.5f, 0.5f),  // Horizontal drift
+            config.baseVelocity + random.range(-1.0 * config.velocityVariation, config.velocityVariation),  // Much more speed variation for height differences
+            random.range(-0.5f, 0.5f)
         );
                 
         // Fixed particle lifetime of 2.5 seconds
         float plife = config.particleLife;
-        float psize = config.particleSize + randomFloat(-0.5f, 0.5f);
+        float psize = config.particleSize + random.range(-0.5f, 0.5f);
         float pgravity = config.particleGravity;
         float pfadeRatio = config.particleFadeRatio;
         glm::vec3 pcolor;
@@ -555,7 +696,7 @@ void GroundParticleSystem::extractFloorPositions(const Map& map) {
     
     // If no floor positions found, create a default floor area as triangles
     if (floorPositions.empty()) {
-        std::cout << "Warning: No floor surfaces found, using default spawn area" << std::endl;
+        SILIC2_LOG_WARN("No floor surfaces found, using default spawn area");
         // Create two triangles forming a default floor (-20 to 20 on x and z axes)
         // Triangle 1
         floorPositions.push_back(glm::vec3(-20.0f, 0.0f, -20.0f));
@@ -569,13 +710,14 @@ void GroundParticleSystem::extractFloorPositions(const Map& map) {
 }
 
 glm::vec3 GroundParticleSystem::getRandomFloorPosition() const {
+    ParticleRandom& random = particleSystem->getRandom();
     if (floorPositions.size() < 3) {
         return glm::vec3(0.0f, 0.0f, 0.0f);
     }
     
     // Select a random triangle (every 3 vertices form a triangle)
     size_t triangleCount = floorPositions.size() / 3;
-    size_t triangleIndex = static_cast<size_t>(randomFloat(0.0f, static_cast<float>(triangleCount - 0.001f)));
+    size_t triangleIndex = static_cast<size_t>(random.range(0.0f, static_cast<float>(triangleCount - 0.001f)));
     size_t baseIndex = triangleIndex * 3;
     
     // Get triangle vertices
@@ -584,8 +726,8 @@ glm::vec3 GroundParticleSystem::getRandomFloorPosition() const {
     glm::vec3 v2 = floorPositions[baseIndex + 2];
     
     // Generate random point within triangle using barycentric coordinates
-    float u = randomFloat(0.0f, 1.0f);
-    float v = randomFloat(0.0f, 1.0f);
+    float u = random.range(0.0f, 1.0f);
+    float v = random.range(0.0f, 1.0f);
     
     // Ensure point is within triangle
     if (u + v > 1.0f) {
@@ -599,11 +741,12 @@ glm::vec3 GroundParticleSystem::getRandomFloorPosition() const {
 }
 
 glm::vec3 GroundParticleSystem::calculateFireColor(float) const {
+    ParticleRandom& random = particleSystem->getRandom();
     // Create vibrant fire colors (white/yellow/orange)
     glm::vec3 color;
     
     // Random selection between white, yellow, and orange
-    float colorChoice = randomFloat(0.0f, 3.0f);
+    float colorChoice = random.range(0.0f, 3.0f);
     
     if (colorChoice < 1.0f) {
         // White (hot core)
@@ -617,12 +760,12 @@ glm::vec3 GroundParticleSystem::calculateFireColor(float) const {
     }
     
     // Add some color variation
-    color.r += randomFloat(-0.1f, 0.1f);
-    color.g += randomFloat(-0.1f, 0.1f);
-    color.b += randomFloat(-0.05f, 0.1f);
+    color.r += random.range(-0.1f, 0.1f);
+    color.g += random.range(-0.1f, 0.1f);
+    color.b += random.range(-0.05f, 0.1f);
     
     // Add high intensity for strong glowing effect
-    float intensity = fireIntensity * (2.0f + randomFloat(-0.3f, 0.3f));
+    float intensity = fireIntensity * (2.0f + random.range(-0.3f, 0.3f));
     color *= intensity;
     
     // Ensure minimum brightness
@@ -1,12 +1,22 @@
 #include "enemy/enemy_manager.h"
 #include "engine/shader.h"
 #include "engine/collision.h"
+#include "engine/job_system.h"
+#include "engine/profiler.h"
+#include "engine/log.h"
 #include <glm/gtc/matrix_transform.hpp>
-#include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace silic2 {
 
+namespace {
+// Bullet query scratch per thread (segments are resolved in parallel jobs)
+thread_local std::vector<uint32_t> segmentCandidates;
+thread_local AABBBatch segmentBoxes;
+} // namespace
+
 // Unit box: X[-0.5,0.5], Y[0,1], Z[-0.5,0.5] with per-face normals (36 vertices)
 static const float BOX_VERTS[] = {
     // Front (Z+)
@@ -43,9 +53,10 @@ void EnemyManager::init() {
             "res/shaders/enemy.frag"
         );
     } catch (const std::exception& e) {
-        std::cerr << "EnemyManager: failed to load shader: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("EnemyManager: failed to load shader: " << e.what());
         throw;
     }
+    lightUniforms = findLightUniforms(*enemyShader);
     setupBoxMesh();
 }
 
@@ -68,30 +79,130 @@ void EnemyManager::setupBoxMesh() {
 }
 
 void EnemyManager::spawnFromMap(const Map& map) {
-    enemies.clear();
+    clear();
     for (const auto& entity : map.getEntities()) {
         if (entity.type == EntityType::ENEMY_SPAWN) {
-            enemies.emplace_back(entity.position);
-            std::cout << "Spawned enemy at ("
+            EnemyHandle handle = enemies.spawn(entity.position);
+            enemyHash.insert(handle.slot, enemies.getAABB(handle.slot));
+            ++spawnedCount;
+            SILIC2_LOG_DEBUG("Spawned enemy at ("
                       << entity.position.x << ", "
                       << entity.position.y << ", "
-                      << entity.position.z << ")\n";
+                      << entity.position.z << ")");
         }
     }
-    std::cout << "EnemyManager: " << enemies.size() << " enemy/enemies spawned.\n";
+    SILIC2_LOG_INFO("EnemyManager: " << spawnedCount << " enemy/enemies spawned.");
 }
 
 void EnemyManager::update(float deltaTime, const glm::vec3& playerPos, const Map* map) {
-    for (auto& enemy : enemies) {
-        enemy.update(deltaTime, playerPos, map);
+    SILIC2_PROFILE_ZONE("EnemyManager::update");
+    computeSeparation();
+
+    // Enemies only read the map and their own separation push, so slot ranges update
+    // in parallel jobs; the hash is refreshed afterwards in slot order
+    enemyMoved.assign(enemies.getSlotCount(), 0);
+    JobSystem::getInstance().parallelFor(enemies.getSlotCount(), UPDATE_JOB_GRAIN, [&](size_t begin, size_t end) {
+        enemies.update(begin, end, deltaTime, playerPos, map,
+                       separationX.data(), separationZ.data(), enemyMoved.data());
+    });
+    for (size_t i = 0; i < enemyMoved.size(); ++i) {
+        if (enemyMoved[i]) {
+            enemyHash.update(static_cast<uint32_t>(i), enemies.getAABB(static_cast<uint32_t>(i)));
+        }
+    }
+}
+
+void EnemyManager::computeSeparation() {
+    const size_t slotCount = enemies.getSlotCount();
+    separationX.assign(slotCount, 0.0f);
+    separationZ.assign(slotCount, 0.0f);
+    if (!separationEnabled || enemies.getLiveCount() < 2) return;
+
+    // Bin live enemies into a uniform XZ grid. Each cell keeps a count and position
+    // sum, so its occupants push as one neighbour at their centroid: the cost per
+    // enemy is a fixed 5x5 cell scan however crowded the area gets.
+    glm::vec2 lo(std::numeric_limits<float>::max());
+    glm::vec2 hi(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        if (!enemies.isLive(i)) continue;
+        glm::vec3 pos = enemies.getPosition(i);
+        glm::vec2 p(pos.x, pos.z);
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
     }
-    removeDeadEnemies();
+    glm::vec2 extent = hi - lo;
+    float cellSize = std::max(SEPARATION_RADIUS * 0.5f,
+                              std::max(extent.x, extent.y) / SEPARATION_MAX_CELLS);
+    float invCell = 1.0f / cellSize;
+    int cellsX = static_cast<int>(extent.x * invCell) + 1;
+    int cellsZ = static_cast<int>(extent.y * invCell) + 1;
+    auto cellOf = [&](const glm::vec3& p, int& cx, int& cz) {
+        cx = std::min(static_cast<int>((p.x - lo.x) * invCell), cellsX - 1);
+        cz = std::min(static_cast<int>((p.z - lo.y) * invCell), cellsZ - 1);
+    };
+
+    separationCount.assign(static_cast<size_t>(cellsX) * cellsZ, 0);
+    separationSum.assign(separationCount.size(), glm::vec2(0.0f));
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        if (!enemies.isLive(i)) continue;
+        glm::vec3 pos = enemies.getPosition(i);
+        int cx, cz;
+        cellOf(pos, cx, cz);
+        size_t c = static_cast<size_t>(cz) * cellsX + cx;
+        separationCount[c]++;
+        separationSum[c] += glm::vec2(pos.x, pos.z);
+    }
+
+    const int reach = static_cast<int>(std::ceil(SEPARATION_RADIUS * invCell));
+
+    // Each enemy only writes its own push
+    JobSystem::getInstance().parallelFor(slotCount, UPDATE_JOB_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!enemies.isLive(static_cast<uint32_t>(i))) continue;
+            glm::vec3 pos = enemies.getPosition(static_cast<uint32_t>(i));
+            glm::vec2 self(pos.x, pos.z);
+            int cx, cz;
+            cellOf(pos, cx, cz);
+
+            glm::vec2 push(0.0f);
+            for (int z = std::max(0, cz - reach); z <= std::min(cellsZ - 1, cz + reach); ++z) {
+                for (int x = std::max(0, cx - reach); x <= std::min(cellsX - 1, cx + reach); ++x) {
+                    size_t c = static_cast<size_t>(z) * cellsX + x;
+                    uint32_t count = separationCount[c];
+                    glm::vec2 sum = separationSum[c];
+                    if (x == cx && z == cz) {
+                        count -= 1;
+                        sum -= self;
+                    }
+                    if (count == 0) continue;
+
+                    glm::vec2 away = self - sum / static_cast<float>(count);
+                    float dist = glm::length(away);
+                    if (dist >= SEPARATION_RADIUS) continue;
+                    if (dist < 1e-4f) {
+                        // Sitting on the centroid: spread by index along the golden angle
+                        float angle = static_cast<float>(i) * 2.39996323f;
+                        away = glm::vec2(std::cos(angle), std::sin(angle));
+                        dist = 0.0f;
+                    } else {
+                        away /= dist;
+                    }
+                    float weight = static_cast<float>(std::min(count, SEPARATION_MAX_CELL_WEIGHT));
+                    push += away * (1.0f - dist / SEPARATION_RADIUS) * weight;
+                }
+            }
+            separationX[i] = push.x * SEPARATION_WEIGHT;
+            separationZ[i] = push.y * SEPARATION_WEIGHT;
+        }
+    });
 }
 
 void EnemyManager::render(const glm::mat4& view, const glm::mat4& projection,
                            const glm::vec3& ambientLight,
-                           const std::vector<MapRenderer::LightData>& lights) {
-    if (!enemyShader || enemies.empty()) return;
+                           const std::vector<MapRenderer::LightData>& lights,
+                           float alpha) {
+    SILIC2_PROFILE_ZONE("EnemyManager::render");
+    if (!enemyShader || enemies.getLiveCount() == 0) return;
 
     enemyShader->use();
     enemyShader->setMat4("view", view);
@@ -100,21 +211,14 @@ void EnemyManager::render(const glm::mat4& view, const glm::mat4& projection,
     enemyShader->setVec3("enemyColor", glm::vec3(1.0f, 0.25f, 0.05f));
 
     // Upload the same light array the map uses
-    int numLights = std::min(static_cast<int>(lights.size()), 128);
-    enemyShader->setInt("numLights", numLights);
-    for (int i = 0; i < numLights; ++i) {
-        std::string base = "lights[" + std::to_string(i) + "]";
-        enemyShader->setVec3(base + ".position",  lights[i].position);
-        enemyShader->setVec3(base + ".color",     lights[i].color);
-        enemyShader->setFloat(base + ".intensity", lights[i].intensity);
-        enemyShader->setFloat(base + ".range",     lights[i].range);
-    }
+    enemyShader->setInt("numLights", uploadLights(lightUniforms, lights));
 
     glBindVertexArray(boxVAO);
 
-    for (const auto& enemy : enemies) {
+    for (uint32_t i = 0; i < enemies.getSlotCount(); ++i) {
+        if (!enemies.isLive(i)) continue;
         glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, enemy.getPosition());
+        model = glm::translate(model, enemies.get(i).getRenderPosition(alpha));
         model = glm::scale(model, glm::vec3(Enemy::BOX_WIDTH, Enemy::BOX_HEIGHT, Enemy::BOX_WIDTH));
 
         enemyShader->setMat4("model", model);
@@ -124,85 +228,88 @@ void EnemyManager::render(const glm::mat4& view, const glm::mat4& projection,
     glBindVertexArray(0);
 }
 
-// Segment-AABB intersection (slab method). Tests segment from 'start' to 'end' (t in [0,1]).
-static bool segmentIntersectsAABB(const glm::vec3& start, const glm::vec3& end,
-                                   const glm::vec3& bMin, const glm::vec3& bMax) {
-    glm::vec3 d = end - start;
-    float tMin = 0.0f, tMax = 1.0f;
-    for (int i = 0; i < 3; ++i) {
-        if (std::abs(d[i]) < 1e-8f) {
-            if (start[i] < bMin[i] || start[i] > bMax[i]) return false;
-        } else {
-            float t1 = (bMin[i] - start[i]) / d[i];
-            float t2 = (bMax[i] - start[i]) / d[i];
-            if (t1 > t2) std::swap(t1, t2);
-            tMin = std::max(tMin, t1);
-            tMax = std::min(tMax, t2);
-            if (tMin > tMax) return false;
+void EnemyManager::checkBulletHits(const SegmentBatch& segments, int damage, std::vector<uint8_t>& hits,
+                                   std::vector<float>* hitT) {
+    hits.assign(segments.size(), 0);
+    if (hitT) hitT->assign(segments.size(), 1.0f);
+    if (enemies.getLiveCount() == 0) return;
+
+    // Nearest enemy along every segment among those alive now, resolved in parallel jobs
+    segmentTargets.resize(segments.size());
+    segmentHitT.resize(segments.size());
+    JobSystem::getInstance().parallelFor(segments.size(), BULLET_JOB_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+            segmentTargets[s] = findSegmentHit(segments, s, segmentHitT[s]);
         }
-    }
-    return true;
-}
+    });
 
-bool EnemyManager::checkBulletHit(const glm::vec3& prevPos, const glm::vec3& pos, int damage) {
-    for (auto& enemy : enemies) {
-        if (enemy.isDead()) continue;
+    // Damage lands in segment order. A segment whose enemy was killed by an earlier one
+    // is resolved again against the survivors; any other nearest hit is unchanged by
+    // removing enemies, so this matches resolving every segment in turn.
+    for (size_t s = 0; s < segments.size(); ++s) {
+        int32_t target = segmentTargets[s];
+        float t = segmentHitT[s];
+        if (target >= 0 && !enemies.isLive(static_cast<uint32_t>(target))) {
+            target = findSegmentHit(segments, s, t);
+        }
+        if (target < 0) continue;
 
-        AABB box = enemy.getAABB();
-        if (segmentIntersectsAABB(prevPos, pos, box.min, box.max)) {
-            enemy.takeDamage(damage);
-            if (enemy.isDead()) {
-                std::cout << "Enemy killed!\n";
-            }
-            return true;
+        uint32_t slot = static_cast<uint32_t>(target);
+        hits[s] = 1;
+        if (hitT) (*hitT)[s] = t;
+        if (enemies.takeDamage(slot, damage)) {
+            // Free the slot right away; later segments in this batch skip it
+            enemyHash.remove(slot);
+            enemies.release(slot);
+            SILIC2_LOG_DEBUG("Enemy killed!");
         }
     }
-    return false;
 }
 
-float EnemyManager::getContactDps(const glm::vec3& playerPos) const {
-    float total = 0.0f;
-    for (const auto& enemy : enemies) {
-        if (!enemy.isDead() && enemy.isTouchingPlayer(playerPos)) {
-            total += CONTACT_DPS;
-        }
+int32_t EnemyManager::findSegmentHit(const SegmentBatch& segments, size_t s, float& t) const {
+    glm::vec3 start(segments.startX[s], segments.startY[s], segments.startZ[s]);
+    glm::vec3 end(segments.endX[s], segments.endY[s], segments.endZ[s]);
+
+    // Gather live enemies in the cells the segment crosses, then run the slab kernel on them
+    enemyHash.querySegment(start, end, segmentCandidates);
+    segmentBoxes.clear();
+    size_t kept = 0;
+    for (uint32_t id : segmentCandidates) {
+        if (!enemies.isLive(id)) continue;
+        segmentCandidates[kept++] = id;
+        segmentBoxes.push(enemyHash.getAABB(id));
     }
-    return total;
+    if (kept == 0) return -1;
+
+    int32_t box = CollisionSystem::intersectSegmentAABBs(start, end, segmentBoxes, t);
+    return box < 0 ? -1 : static_cast<int32_t>(segmentCandidates[box]);
 }
 
-bool EnemyManager::allEnemiesDead() const {
-    for (const auto& enemy : enemies) {
-        if (!enemy.isDead()) return false;
-    }
-    return true;
+float EnemyManager::getContactDps(const glm::vec3& playerPos) const {
+    return static_cast<float>(enemies.countTouching(playerPos)) * CONTACT_DPS;
 }
 
-size_t EnemyManager::getLiveCount() const {
-    size_t count = 0;
-    for (const auto& enemy : enemies) {
-        if (!enemy.isDead()) ++count;
+FrameVector<glm::vec3> EnemyManager::getEnemyPositions(FrameArena& arena) const {
+    auto positions = makeFrameVector<glm::vec3>(arena, enemies.getLiveCount());
+    for (uint32_t i = 0; i < enemies.getSlotCount(); ++i) {
+        if (enemies.isLive(i)) positions.push_back(enemies.getPosition(i));
     }
-    return count;
+    return positions;
 }
 
-std::vector<glm::vec3> EnemyManager::getEnemyPositions() const {
-    std::vector<glm::vec3> positions;
-    for (const auto& enemy : enemies) {
-        if (!enemy.isDead()) positions.push_back(enemy.getPosition());
+FrameVector<glm::vec3> EnemyManager::getEnemyPositions(const glm::vec3& center, float radius, FrameArena& arena) const {
+    enemyHash.queryRadius(center, radius, nearbyEnemies);
+    auto positions = makeFrameVector<glm::vec3>(arena, nearbyEnemies.size());
+    for (uint32_t id : nearbyEnemies) {
+        if (enemies.isLive(id)) positions.push_back(enemies.getPosition(id));
     }
     return positions;
 }
 
 void EnemyManager::clear() {
     enemies.clear();
-}
-
-void EnemyManager::removeDeadEnemies() {
-    enemies.erase(
-        std::remove_if(enemies.begin(), enemies.end(),
-            [](const Enemy& e) { return e.isDead(); }),
-        enemies.end()
-    );
+    enemyHash.clear();
+    spawnedCount = 0;
 }
 
 } // namespace silic2
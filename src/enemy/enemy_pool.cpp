@@ -0,0 +1,224 @@
+#include "enemy/enemy_pool.h"
+#include "engine/map.h"
+#include "engine/collision.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace silic2 {
+
+namespace {
+// Broadphase scratch shared by all enemies on this thread (avoids per-query allocations)
+thread_local std::vector<uint32_t> nearbyBrushes;
+} // namespace
+
+EnemyHandle EnemyPool::spawn(const glm::vec3& position, int hpMax) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(posX.size());
+        for (auto* field : {&posX, &posY, &posZ, &prevX, &prevY, &prevZ, &velocityY, &moveX, &moveZ}) {
+            field->push_back(0.0f);
+        }
+        hp.push_back(0);
+        maxHp.push_back(0);
+        state.push_back(EnemyState::DEAD);
+        live.push_back(0);
+        generation.push_back(0);
+    }
+
+    posX[slot] = prevX[slot] = position.x;
+    posY[slot] = prevY[slot] = position.y;
+    posZ[slot] = prevZ[slot] = position.z;
+    velocityY[slot] = 0.0f;
+    moveX[slot] = moveZ[slot] = 0.0f;
+    hp[slot] = hpMax;
+    maxHp[slot] = hpMax;
+    state[slot] = EnemyState::IDLE;
+    live[slot] = 1;
+    ++liveCount;
+    return {slot, generation[slot]};
+}
+
+void EnemyPool::release(uint32_t slot) {
+    if (!isLive(slot)) return;
+    live[slot] = 0;
+    state[slot] = EnemyState::DEAD;
+    ++generation[slot];
+    freeSlots.push_back(slot);
+    --liveCount;
+}
+
+void EnemyPool::clear() {
+    for (auto* field : {&posX, &posY, &posZ, &prevX, &prevY, &prevZ, &velocityY, &moveX, &moveZ}) {
+        field->clear();
+    }
+    hp.clear();
+    maxHp.clear();
+    state.clear();
+    live.clear();
+    generation.clear();
+    freeSlots.clear();
+    liveCount = 0;
+}
+
+AABB EnemyPool::getAABB(uint32_t slot) const {
+    return AABB(
+        glm::vec3(posX[slot] - HALF_W, posY[slot],                     posZ[slot] - HALF_W),
+        glm::vec3(posX[slot] + HALF_W, posY[slot] + Enemy::BOX_HEIGHT, posZ[slot] + HALF_W)
+    );
+}
+
+bool EnemyPool::takeDamage(uint32_t slot, int amount) {
+    if (!isLive(slot) || hp[slot] <= 0) return false;
+    hp[slot] -= amount;
+    if (hp[slot] <= 0) {
+        hp[slot] = 0;
+        state[slot] = EnemyState::DEAD;
+        return true;
+    }
+    return false;
+}
+
+void EnemyPool::update(size_t begin, size_t end, float deltaTime, const glm::vec3& playerPos, const Map* map,
+                       const float* separationX, const float* separationZ, uint8_t* moved) {
+    // Free slots are carried along in the branch-free loops and skipped in the others
+
+    for (size_t i = begin; i < end; ++i) {
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        prevZ[i] = posZ[i];
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        if (live[i]) applyGravityAndGround(static_cast<uint32_t>(i), deltaTime, map);
+    }
+
+    // Chase the player inside aggro range, plus the separation push. Gravity only moved
+    // Y, so this reads the same XZ the chase would have seen right after it.
+    for (size_t i = begin; i < end; ++i) {
+        float dx = playerPos.x - posX[i];
+        float dz = playerPos.z - posZ[i];
+        float dist = std::sqrt(dx * dx + dz * dz);
+        bool chasing = dist < AGGRO_RANGE;
+        bool aimed = chasing && dist >= 0.01f;
+        float safeDist = std::max(dist, 0.01f);
+
+        float steerX = (aimed ? dx / safeDist : 0.0f) + separationX[i];
+        float steerZ = (aimed ? dz / safeDist : 0.0f) + separationZ[i];
+        float len = std::sqrt(steerX * steerX + steerZ * steerZ);
+        float safeLen = std::max(len, 1.0f);
+        if (len > 1.0f) {
+            steerX = steerX / safeLen;
+            steerZ = steerZ / safeLen;
+        }
+        bool moving = len >= 1e-4f;
+        moveX[i] = moving ? steerX * MOVE_SPEED * deltaTime : 0.0f;
+        moveZ[i] = moving ? steerZ * MOVE_SPEED * deltaTime : 0.0f;
+
+        EnemyState next = chasing ? EnemyState::CHASING : EnemyState::IDLE;
+        state[i] = live[i] ? next : state[i];
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        if (!live[i]) continue;
+        if (moveX[i] != 0.0f || moveZ[i] != 0.0f) moveHorizontal(static_cast<uint32_t>(i), map);
+        moved[i] = posX[i] != prevX[i] || posY[i] != prevY[i] || posZ[i] != prevZ[i];
+    }
+}
+
+size_t EnemyPool::countTouching(const glm::vec3& playerPos) const {
+    size_t touching = 0;
+    const size_t count = posX.size();
+    for (size_t i = 0; i < count; ++i) {
+        float dx = posX[i] - playerPos.x;
+        float dz = posZ[i] - playerPos.z;
+        bool inRange = std::sqrt(dx * dx + dz * dz) < Enemy::TOUCH_RANGE;
+        touching += (live[i] && hp[i] > 0 && inRange) ? 1 : 0;
+    }
+    return touching;
+}
+
+void EnemyPool::applyGravityAndGround(uint32_t slot, float deltaTime, const Map* map) {
+    float& vy = velocityY[slot];
+    if (!checkGroundBelow(slot, map)) {
+        vy += GRAVITY * deltaTime;
+        vy = std::max(vy, MAX_FALL);
+    } else {
+        vy = 0.0f;
+    }
+
+    posY[slot] += vy * deltaTime;
+
+    // Re-check ground after moving; snap if we landed
+    if (checkGroundBelow(slot, map) && vy <= 0.0f) {
+        vy = 0.0f;
+
+        // Snap feet to the top of the highest brush below
+        if (map) {
+            float x = posX[slot], y = posY[slot], z = posZ[slot];
+            float highestTop = 0.0f;
+            AABB groundProbe(
+                glm::vec3(x - HALF_W, y - GROUND_EPS, z - HALF_W),
+                glm::vec3(x + HALF_W, y,              z + HALF_W)
+            );
+            float groundTop;
+            if (map->getHeightfield().findGround(groundProbe, y + 0.1f, groundTop)) {
+                highestTop = std::max(highestTop, groundTop);
+            }
+            posY[slot] = highestTop + GROUND_EPS;
+        }
+    }
+}
+
+bool EnemyPool::checkGroundBelow(uint32_t slot, const Map* map) const {
+    if (!map) return false;
+
+    float x = posX[slot], y = posY[slot], z = posZ[slot];
+    AABB groundProbe(
+        glm::vec3(x - HALF_W, y - GROUND_EPS, z - HALF_W),
+        glm::vec3(x + HALF_W, y,              z + HALF_W)
+    );
+
+    float groundTop;
+    return map->getHeightfield().findGround(groundProbe, y + 0.1f, groundTop);
+}
+
+void EnemyPool::moveHorizontal(uint32_t slot, const Map* map) {
+    glm::vec3 result(moveX[slot], 0.0f, moveZ[slot]);
+    if (map) {
+        AABB current = getAABB(slot);
+        const auto& bounds = map->getBrushBounds();
+
+        // Broadphase once for the whole horizontal move
+        AABB sweptBox(glm::min(current.min, current.min + result),
+                      glm::max(current.max, current.max + result));
+        map->getBrushGrid().query(sweptBox, nearbyBrushes);
+
+        // Axis-separated resolution: try X, then Z independently
+        for (int axis = 0; axis < 2; ++axis) {
+            glm::vec3 axisMove(0.0f);
+            if (axis == 0) axisMove.x = result.x;
+            else           axisMove.z = result.z;
+
+            AABB moved(current.min + axisMove, current.max + axisMove);
+
+            for (uint32_t i : nearbyBrushes) {
+                // Skip zero-thickness horizontal brushes (floors/ceilings) — not walls
+                if (bounds.isFlatHorizontal(i)) continue;
+                if (CollisionSystem::checkAABB(moved, bounds.getAABB(i))) {
+                    if (axis == 0) result.x = 0.0f;
+                    else           result.z = 0.0f;
+                    break;
+                }
+            }
+        }
+    }
+
+    posX[slot] += result.x;
+    posZ[slot] += result.z;
+}
+
+} // namespace silic2
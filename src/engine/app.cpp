@@ -14,9 +14,17 @@
 #include "hud/crosshair.h"
 #include "hud/minimap.h"
 #include "hud/hud_renderer.h"
+#include "hud/profiler_overlay.h"
 #include "engine/game_config.h"
+#include "engine/input_recording.h"
+#include "engine/job_system.h"
+#include "engine/profiler.h"
+#include "engine/gpu_profiler.h"
+#include "engine/stream_buffer.h"
+#include "engine/log.h"
 #include <algorithm>
-#include <iostream>
+#include <cmath>
+#include <random>
 #include <stdexcept>
 
 namespace silic2 {
@@ -30,24 +38,30 @@ App::App() : window(nullptr) {
         throw std::runtime_error("Failed to initialize OpenGL");
     }
     
+    // Worker threads for the parallel simulation passes
+    int workerThreads = GameConfig::getInstance().simulation.workerThreads;
+    JobSystem::getInstance().start(workerThreads < 0 ? JobSystem::defaultWorkerCount()
+                                                     : static_cast<unsigned>(workerThreads));
+    SILIC2_LOG_INFO("Job system: " << JobSystem::getInstance().getWorkerCount() << " worker thread(s)");
+    
     // Initialize after OpenGL is ready
     try {
-        std::cout << "Creating Map..." << std::endl;
+        SILIC2_LOG_INFO("Creating Map...");
         currentMap = std::make_unique<Map>();
-        std::cout << "Map created successfully" << std::endl;
+        SILIC2_LOG_INFO("Map created successfully");
         
-        std::cout << "Creating MapRenderer..." << std::endl;
+        SILIC2_LOG_INFO("Creating MapRenderer...");
         mapRenderer = std::make_unique<MapRenderer>();
-        std::cout << "MapRenderer created successfully" << std::endl;
+        SILIC2_LOG_INFO("MapRenderer created successfully");
         
-        std::cout << "Creating PixelRenderer..." << std::endl;
+        SILIC2_LOG_INFO("Creating PixelRenderer...");
         pixelRenderer = std::make_unique<PixelRenderer>();
         // Initialize with configured resolution
         const auto& renderConfig = GameConfig::getInstance().render;
         if (!pixelRenderer->init(renderConfig.pixelWidth, renderConfig.pixelHeight)) {
             throw std::runtime_error("Failed to initialize PixelRenderer");
         }
-        std::cout << "PixelRenderer created successfully" << std::endl;
+        SILIC2_LOG_INFO("PixelRenderer created successfully");
         
         // Create camera
         camera = std::make_unique<Camera>(glm::vec3(0.0f, 5.0f, 5.0f));
@@ -63,6 +77,12 @@ App::App() : window(nullptr) {
         
         // Create enhanced ground particle system
         groundParticles = createEnhancedGroundParticleSystem(2000, GroundParticleSystem::GParticleMode::FIRE);
+        if (GameConfig::getInstance().effects.gpuParticles) {
+            groundParticles->setBackend(ParticleBackend::GPU);
+        }
+        if (!GameConfig::getInstance().effects.groundParticleCollision) {
+            groundParticles->setCollision(ParticleCollision::NONE);
+        }
 
         // Create enemy manager
         enemyManager = std::make_unique<EnemyManager>();
@@ -79,8 +99,18 @@ App::App() : window(nullptr) {
         // Create HUD renderer (player bar + enemy bars)
         hudRenderer = std::make_unique<HudRenderer>();
         hudRenderer->init();
+
+#if SILIC2_PROFILE
+        profilerOverlay = std::make_unique<ProfilerOverlay>();
+        profilerOverlay->init();
+
+        gpuProfiler = std::make_unique<GpuProfiler>();
+        if (!gpuProfiler->init()) {
+            gpuProfiler.reset();
+        }
+#endif
     } catch (const std::exception& e) {
-        std::cerr << "Failed to initialize rendering system: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Failed to initialize rendering system: " << e.what());
         throw;
     }
     
@@ -99,6 +129,8 @@ App::~App() {
 }
 
 void App::cleanup() {
+    JobSystem::getInstance().stop();
+    StreamBuffer::getInstance().shutdown();
     if (window) {
         glfwDestroyWindow(window);
     }
@@ -106,10 +138,10 @@ void App::cleanup() {
 }
 
 bool App::initWindow() {
-    std::cout << "Initializing GLFW..." << std::endl;
+    SILIC2_LOG_INFO("Initializing GLFW...");
     
     if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
+        SILIC2_LOG_ERROR("Failed to initialize GLFW");
         return false;
     }
     
@@ -117,31 +149,31 @@ bool App::initWindow() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     
-    std::cout << "Creating window..." << std::endl;
+    SILIC2_LOG_INFO("Creating window...");
     
     const auto& config = GameConfig::getInstance().window;
     window = glfwCreateWindow(config.width, config.height, config.title.c_str(), nullptr, nullptr);
     if (!window) {
-        std::cerr << "Failed to create GLFW window" << std::endl;
+        SILIC2_LOG_ERROR("Failed to create GLFW window");
         glfwTerminate();
         return false;
     }
     
     glfwMakeContextCurrent(window);
-    std::cout << "Window created successfully" << std::endl;
+    SILIC2_LOG_INFO("Window created successfully");
     return true;
 }
 
 bool App::initOpenGL() {
-    std::cout << "Loading OpenGL functions..." << std::endl;
+    SILIC2_LOG_INFO("Loading OpenGL functions...");
     
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "Failed to initialize GLAD" << std::endl;
+        SILIC2_LOG_ERROR("Failed to initialize GLAD");
         return false;
     }
     
-    std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
-    std::cout << "GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
+    SILIC2_LOG_INFO("OpenGL Version: " << glGetString(GL_VERSION));
+    SILIC2_LOG_INFO("GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION));
     
     const auto& config = GameConfig::getInstance().window;
     glViewport(0, 0, config.width, config.height);
@@ -151,59 +183,217 @@ bool App::initOpenGL() {
         glEnable(GL_DEPTH_TEST);
     }
     
-    std::cout << "OpenGL initialized successfully" << std::endl;
+    SILIC2_LOG_INFO("OpenGL initialized successfully");
     return true;
 }
 
 void App::run() {
-    // Reset lastFrame here so initialization time doesn't inflate the first deltaTime
+    // Reset lastFrame here so initialization time doesn't inflate the first frame
     lastFrame = static_cast<float>(glfwGetTime());
+    accumulator = 0.0f;
+    prevCameraPosition = camera->getPosition();
 
     while (!glfwWindowShouldClose(window)) {
+#if SILIC2_PROFILE
+        // Collect the zones of the frame that just ended
+        Profiler::getInstance().endFrame();
+        processProfilerKeys();
+#endif
+        SILIC2_PROFILE_ZONE("App::run frame");
+        const auto& sim = GameConfig::getInstance().simulation;
+        const float tickDt = 1.0f / std::max(sim.tickRate, 1.0f);
+
         float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = std::min(currentFrame - lastFrame, 0.05f); // cap at 50ms (20 FPS floor)
+        accumulator += std::min(currentFrame - lastFrame, sim.maxFrameTime);
         lastFrame = currentFrame;
         
-        processInput();
-        update(deltaTime);
+        // Simulate in whole ticks; the remainder carries over to the next frame
+        int ticks = 0;
+        while (accumulator >= tickDt && ticks < sim.maxTicksPerFrame) {
+            if (inputMode == InputMode::REPLAYING && replayTick >= recording.ticks.size()) {
+                SILIC2_LOG_INFO("Replay finished after " << replayTick << " ticks");
+                glfwSetWindowShouldClose(window, GLFW_TRUE);
+                break;
+            }
+            deltaTime = tickDt;
+            prevCameraPosition = camera->getPosition();
+            processInput();
+            update(tickDt);
+            accumulator -= tickDt;
+            ++ticks;
+        }
+        // Still behind after the per-frame limit: drop the backlog instead of spiralling
+        if (accumulator >= tickDt) {
+            accumulator = std::fmod(accumulator, tickDt);
+        }
+        
+        renderAlpha = sim.interpolate ? accumulator / tickDt : 1.0f;
         render();
+        StreamBuffer::getInstance().endFrame();
         
-        glfwSwapBuffers(window);
+        {
+            SILIC2_PROFILE_ZONE("App::run swap");
+            glfwSwapBuffers(window);
+        }
         glfwPollEvents();
     }
+    
+    if (inputMode == InputMode::RECORDING) {
+        if (recording.save(recordingPath)) {
+            SILIC2_LOG_INFO("Saved " << recording.ticks.size() << " ticks of input to " << recordingPath);
+        }
+        inputMode = InputMode::LIVE;
+    }
 }
 
 void App::processInput() {
+    TickInput input;
+    if (inputMode == InputMode::REPLAYING) {
+        input = recording.ticks[replayTick++];
+    } else {
+        input = sampleInput();
+        if (inputMode == InputMode::RECORDING) recording.ticks.push_back(input);
+    }
+    applyInput(input);
+}
+
+void App::processProfilerKeys() {
+#if SILIC2_PROFILE
+    // F3: toggle the overlay (edge-triggered). It has no text, so print the legend.
+    bool overlayKey = glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS;
+    if (overlayKey && !profilerKeyWasPressed) {
+        showProfiler = !showProfiler;
+        if (showProfiler) {
+            const ProfileSummary& summary = Profiler::getInstance().getSummary();
+            SILIC2_LOG_INFO("Heap allocations last frame: " << summary.frameAllocations
+                      << " (" << summary.frameAllocatedBytes << " bytes), frame arena peak: "
+                      << frameArena.getPeak() << " bytes");
+            SILIC2_LOG_INFO("Profiler zones (ms per frame):");
+            for (size_t i = 0; i < summary.zoneNames.size(); ++i) {
+                SILIC2_LOG_INFO("  " << ProfilerOverlay::zoneColorName(i) << "\t" << summary.zoneMs[i]
+                          << "\t" << summary.zoneNames[i]);
+            }
+            if (gpuProfiler) {
+                [[maybe_unused]] const GpuFrameStats& gpu = gpuProfiler->getLatestStats();
+                SILIC2_LOG_INFO("GPU passes (ms, frame " << gpu.frame << "):");
+                for (size_t i = 0; i < GpuFrameStats::PASS_COUNT; ++i) {
+                    SILIC2_LOG_INFO("  " << ProfilerOverlay::zoneColorName(i) << "\t" << gpu.passMs[i]
+                              << "\t" << GpuProfiler::passName(static_cast<GpuPass>(i)));
+                }
+            }
+        }
+    }
+    profilerKeyWasPressed = overlayKey;
+
+    // F4: write the next TRACE_FRAMES frames to a Chrome trace (edge-triggered)
+    constexpr size_t TRACE_FRAMES = 300;
+    bool traceKey = glfwGetKey(window, GLFW_KEY_F4) == GLFW_PRESS;
+    if (traceKey && !traceKeyWasPressed && !Profiler::getInstance().isCapturing()) {
+        Profiler::getInstance().captureFrames(TRACE_FRAMES, "profile_trace.json");
+        SILIC2_LOG_INFO("Capturing " << TRACE_FRAMES << " frames to profile_trace.json");
+    }
+    traceKeyWasPressed = traceKey;
+#endif
+}
+
+TickInput App::sampleInput() {
+    TickInput input;
+    input.player.forward = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+    input.player.back    = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+    input.player.left    = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+    input.player.right   = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+    input.player.jump    = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    input.player.sprint  = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS;
+    input.player.crouch  = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS;
+    input.player.godMode = glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS;
+    input.fire           = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+    input.toggleFireMode = glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS;
+    input.pause          = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
+
+    // Mouse motion since the last tick belongs to this tick
+    input.look = pendingLook;
+    pendingLook = glm::vec2(0.0f);
+    return input;
+}
+
+void App::applyInput(const TickInput& input) {
     // ESC key: toggle PAUSED <-> PLAYING (edge-triggered)
-    bool escNow = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
-    if (escNow && !escWasPressed) {
+    if (input.pause && !escWasPressed) {
         if (gameState == GameState::PLAYING)
             setState(GameState::PAUSED);
         else if (gameState == GameState::PAUSED)
             setState(GameState::PLAYING);
     }
-    escWasPressed = escNow;
+    escWasPressed = input.pause;
 
     // Skip all other input when not PLAYING
     if (gameState != GameState::PLAYING) return;
 
+    // Mouse look: use player's mouse handling if player exists, otherwise use camera directly
+    if (input.look != glm::vec2(0.0f)) {
+        if (player) {
+            player->processMouseMovement(camera.get(), input.look.x, input.look.y);
+        } else {
+            camera->processMouseMovement(input.look.x, input.look.y);
+        }
+    }
+
     // Player movement and input
     if (player) {
-        player->processInput(window, camera.get(), deltaTime);
+        player->processInput(input.player, camera.get(), deltaTime);
+    }
+
+    // Q key: toggle projectile / hitscan fire mode (edge-triggered)
+    if (input.toggleFireMode && !fireModeWasPressed && weapon) {
+        bool hitscan = weapon->getFireMode() == Weapon::FireMode::HITSCAN;
+        weapon->setFireMode(hitscan ? Weapon::FireMode::PROJECTILE : Weapon::FireMode::HITSCAN);
+        SILIC2_LOG_INFO("Fire mode: " << (hitscan ? "projectile" : "hitscan"));
     }
+    fireModeWasPressed = input.toggleFireMode;
 
     // Weapon input - hold left mouse button to spray
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && weapon) {
+    if (input.fire && weapon) {
         weapon->fire(*camera);
     }
 }
 
+bool App::startRecording(const std::string& path) {
+    recording.clear();
+    recording.mapPath = currentMap ? currentMap->getFilename() : std::string();
+    recording.seed = std::random_device{}();
+    recording.tickRate = GameConfig::getInstance().simulation.tickRate;
+    recording.godMode = GameConfig::getInstance().player.enableGodMode;
+    seedParticleRandom(recording.seed);
+
+    recordingPath = path;
+    inputMode = InputMode::RECORDING;
+    SILIC2_LOG_INFO("Recording input to " << path << " (seed " << recording.seed << ")");
+    return true;
+}
+
+bool App::startReplay(const std::string& path) {
+    if (!recording.load(path)) return false;
+    if (!loadMap(recording.mapPath)) return false;
+
+    // Reproduce the recorded session's settings before the first tick
+    auto& config = GameConfig::getInstance();
+    config.simulation.tickRate = recording.tickRate;
+    config.player.enableGodMode = recording.godMode;
+    seedParticleRandom(recording.seed);
+
+    replayTick = 0;
+    inputMode = InputMode::REPLAYING;
+    SILIC2_LOG_INFO("Replaying " << recording.ticks.size() << " ticks from " << path);
+    return true;
+}
+
 void App::setState(GameState next) {
     gameState  = next;
     stateTimer = 0.0f;
 }
 
 void App::update(float deltaTime) {
+    SILIC2_PROFILE_ZONE("App::update");
     stateTimer += deltaTime;
     switch (gameState) {
         case GameState::PLAYING:      updatePlaying(deltaTime);      break;
@@ -214,46 +404,65 @@ void App::update(float deltaTime) {
 }
 
 void App::updatePlaying(float dt) {
-    // Update player
-    if (player) {
-        player->update(dt, currentMap.get());
+    // Built once and rerun every tick; the tasks read the tick length from tickGraphDt
+    tickGraphDt = dt;
+    if (tickGraph.size() == 0) buildTickGraph();
+    tickGraph.run(JobSystem::getInstance());
 
-        // Update camera to follow player with bobbing/shake effects
-        glm::vec3 eyePos = player->getEyePosition();
-        glm::vec3 cameraOffset = player->getCameraOffset();
-        camera->setPosition(eyePos + cameraOffset);
+    // State transitions
+    if (enemyManager && player) {
+        if (player->isDead()) {
+            setState(GameState::PLAYER_DEAD);
+        } else if (enemyManager->allEnemiesDead() && enemyManager->getTotalCount() > 0) {
+            setState(GameState::ROOM_CLEARED);
+        }
     }
+}
 
-    // Update camera
-    camera->update();
+void App::buildTickGraph() {
+    // Player and weapon touch disjoint state and run side by side. Enemies need the
+    // new player position and this tick's bullet damage. Ground particles depend on
+    // nothing: every particle system draws from its own random stream.
+    auto playerTask = tickGraph.add([this]() {
+        if (player) {
+            player->update(tickGraphDt, currentMap.get());
 
-    // Update weapon — passes enemy manager for bullet-enemy collision
-    if (weapon) {
-        weapon->update(dt, currentMap.get(), enemyManager.get());
-    }
+            // Update camera to follow player with bobbing/shake effects
+            glm::vec3 eyePos = player->getEyePosition();
+            glm::vec3 cameraOffset = player->getCameraOffset();
+            camera->setPosition(eyePos + cameraOffset);
+        }
 
-    // Update enemies
-    if (enemyManager && player) {
-        enemyManager->update(dt, player->getPosition(), currentMap.get());
+        // Update camera
+        camera->update();
+    });
 
-        // Apply contact damage to player
-        float dps = enemyManager->getContactDps(player->getPosition());
-        if (dps > 0.0f) {
-            player->takeDamage(dps * dt);
+    // Update weapon — passes enemy manager for bullet-enemy collision
+    auto weaponTask = tickGraph.add([this]() {
+        if (weapon) {
+            weapon->update(tickGraphDt, currentMap.get(), enemyManager.get());
         }
+    });
 
-        // State transitions
-        if (player->isDead()) {
-            setState(GameState::PLAYER_DEAD);
-        } else if (enemyManager->allEnemiesDead() && enemyManager->getTotalCount() > 0) {
-            setState(GameState::ROOM_CLEARED);
+    // Update enemies
+    tickGraph.add([this]() {
+        if (enemyManager && player) {
+            enemyManager->update(tickGraphDt, player->getPosition(), currentMap.get());
+
+            // Apply contact damage to player
+            float dps = enemyManager->getContactDps(player->getPosition());
+            if (dps > 0.0f) {
+                player->takeDamage(dps * tickGraphDt);
+            }
         }
-    }
+    }, {playerTask, weaponTask});
 
     // Update ground particle system
-    if (groundParticles) {
-        groundParticles->update(dt);
-    }
+    tickGraph.add([this]() {
+        if (groundParticles) {
+            groundParticles->update(tickGraphDt);
+        }
+    });
 }
 
 void App::handleRoomCleared(float dt) {
@@ -261,7 +470,7 @@ void App::handleRoomCleared(float dt) {
     // Phase 5.3: show augment select screen
     // Phase 5.1: show node map
     if (stateTimer < 0.1f)
-        std::cout << "Room cleared!\n";
+        SILIC2_LOG_INFO("Room cleared!");
     if (stateTimer >= 1.0f)
         setState(GameState::PLAYING);
 }
@@ -273,17 +482,33 @@ void App::handlePlayerDead(float dt) {
     glm::vec3 pos = start ? start->position : glm::vec3(0.0f, 2.0f, 0.0f);
     player->respawn(pos);
     camera->setPosition(pos + glm::vec3(0.0f, 1.6f, 0.0f));
+    prevCameraPosition = camera->getPosition();  // Teleport: don't interpolate across the map
     if (enemyManager) enemyManager->spawnFromMap(*currentMap);
     setState(GameState::PLAYING);
 }
 
 void App::render() {
+    SILIC2_PROFILE_ZONE("App::render");
+    if (gpuProfiler) gpuProfiler->beginFrame();
+    frameArena.reset();
+
     // Start rendering to low-res pixel buffer
     pixelRenderer->beginPixelRender();
     
     // Create view and projection matrices
     // Use pixel buffer dimensions for proper aspect ratio
-    glm::mat4 view = camera->getViewMatrix();
+    // The eye is blended between the last two ticks. Mouse motion the simulation has not
+    // consumed yet is previewed on a copy of the camera so looking around is never delayed.
+    glm::vec3 eye = glm::mix(prevCameraPosition, camera->getPosition(), renderAlpha);
+    Camera viewCamera = *camera;
+    if (gameState == GameState::PLAYING && pendingLook != glm::vec2(0.0f)) {
+        if (player) {
+            player->processMouseMovement(&viewCamera, pendingLook.x, pendingLook.y);
+        } else {
+            viewCamera.processMouseMovement(pendingLook.x, pendingLook.y);
+        }
+    }
+    glm::mat4 view = viewCamera.getViewMatrix(eye);
     
     // Use player's current FOV if player exists
     glm::mat4 projection;
@@ -298,6 +523,7 @@ void App::render() {
     
     // Render map if loaded
     if (currentMap && mapRenderer) {
+        GpuPassScope gpuPass(gpuProfiler.get(), GpuPass::MAP);
         const auto& worldSettings = currentMap->getWorldSettings();
         glClearColor(worldSettings.backgroundColor.r, 
                      worldSettings.backgroundColor.g, 
@@ -309,8 +535,7 @@ void App::render() {
         
         // Add bullet lights to map renderer
         if (weapon) {
-            auto bulletLights = weapon->getActiveLights();
-            for (const auto& [pos, color] : bulletLights) {
+            for (const auto& [pos, color] : weapon->getActiveLights(frameArena)) {
                 // color already includes intensity, so set intensity to 1.0 here
                 mapRenderer->addDynamicLight(pos, color, 1.0f, 3.0f);
             }
@@ -321,44 +546,62 @@ void App::render() {
     
     // Render weapon bullets
     if (weapon) {
-        weapon->render(view, projection);
+        GpuPassScope gpuPass(gpuProfiler.get(), GpuPass::BULLETS);
+        weapon->render(view, projection, renderAlpha);
     }
 
     // Render enemies with the same light list the map just used
     if (enemyManager && currentMap && mapRenderer) {
+        GpuPassScope gpuPass(gpuProfiler.get(), GpuPass::ENEMIES);
         const auto& ws = currentMap->getWorldSettings();
         enemyManager->render(view, projection, ws.ambientLight,
-                             mapRenderer->getCombinedLights());
+                             mapRenderer->getCombinedLights(), renderAlpha);
     }
     
     // Render ground particle system if enabled
     const auto& effectsConfig = GameConfig::getInstance().effects;
     if (groundParticles && effectsConfig.enableGroundParticles) {
+        GpuPassScope gpuPass(gpuProfiler.get(), GpuPass::PARTICLES);
         groundParticles->render(view, projection);
     }
     
     // End pixel rendering and display to screen
     const auto& config = GameConfig::getInstance().window;
-    pixelRenderer->endPixelRender(config.width, config.height);
+    {
+        GpuPassScope gpuPass(gpuProfiler.get(), GpuPass::PIXEL_POST);
+        pixelRenderer->endPixelRender(config.width, config.height);
+    }
 
     // Draw HUD overlays at native resolution on top of everything
-    crosshair->render(config.width, config.height);
+    {
+        GpuPassScope gpuPass(gpuProfiler.get(), GpuPass::HUD);
+        crosshair->render(config.width, config.height);
+
+        if (minimap && enemyManager) {
+            minimap->render(
+                eye,
+                viewCamera.getFront(),
+                enemyManager->getEnemyPositions(eye, minimap->getEnemyQueryRadius(), frameArena),
+                config.width, config.height, frameArena);
+        }
 
-    if (minimap && enemyManager) {
-        minimap->render(
-            camera->getPosition(),
-            camera->getFront(),
-            enemyManager->getEnemyPositions(),
-            config.width, config.height);
+        if (hudRenderer && player && enemyManager) {
+            hudRenderer->render(
+                config.width, config.height,
+                player->getHp(), player->getMaxHp(),
+                enemyManager->getEnemies(),
+                view, projection, renderAlpha);
+        }
     }
 
-    if (hudRenderer && player && enemyManager) {
-        hudRenderer->render(
-            config.width, config.height,
-            player->getHp(), player->getMaxHp(),
-            enemyManager->getEnemies(),
-            view, projection);
+#if SILIC2_PROFILE
+    if (gpuProfiler) gpuProfiler->endFrame();
+    // Drawn after the last timed pass, so the overlay does not measure itself
+    if (showProfiler && profilerOverlay) {
+        profilerOverlay->render(config.width, config.height, Profiler::getInstance().getSummary(),
+                                gpuProfiler ? &gpuProfiler->getLatestStats() : nullptr);
     }
+#endif
 }
 
 void App::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
@@ -381,11 +624,10 @@ void App::mouseCallback(GLFWwindow* window, double xpos, double ypos) {
     float yoffset = app->camera->getLastY() - yposf; // Reversed since y coordinates go from bottom to top
     app->camera->setLastMousePos(xposf, yposf);
     
-    // Use player's mouse handling if player exists, otherwise use camera directly
-    if (app->player) {
-        app->player->processMouseMovement(app->camera.get(), xoffset, yoffset);
-    } else {
-        app->camera->processMouseMovement(xoffset, yoffset);
+    // Applied by the next simulation tick (and previewed by render until then);
+    // replays take their mouse motion from the recording
+    if (app->inputMode != InputMode::REPLAYING) {
+        app->pendingLook += glm::vec2(xoffset, yoffset);
     }
 }
 
@@ -398,23 +640,23 @@ void App::scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
 }
 
 bool App::loadMap(const std::string& mapFile) {
-    std::cout << "Attempting to load map: " << mapFile << std::endl;
+    SILIC2_LOG_INFO("Attempting to load map: " << mapFile);
     
     if (!currentMap->loadFromFile(mapFile)) {
-        std::cerr << "Failed to load map: " << mapFile << std::endl;
+        SILIC2_LOG_ERROR("Failed to load map: " << mapFile);
         return false;
     }
     
-    std::cout << "Map loaded successfully. Brushes: " << currentMap->getBrushes().size() 
+    SILIC2_LOG_INFO("Map loaded successfully. Brushes: " << currentMap->getBrushes().size() 
               << ", Entities: " << currentMap->getEntities().size() 
-              << ", Lights: " << currentMap->getLights().size() << std::endl;
+              << ", Lights: " << currentMap->getLights().size());
     
     if (!mapRenderer->loadMap(*currentMap)) {
-        std::cerr << "Failed to load map into renderer" << std::endl;
+        SILIC2_LOG_ERROR("Failed to load map into renderer");
         return false;
     }
     
-    std::cout << "Map loaded into renderer successfully" << std::endl;
+    SILIC2_LOG_INFO("Map loaded into renderer successfully");
     
     // Position player at player start if available
     Entity* playerStart = currentMap->getPlayerStart();
@@ -423,10 +665,11 @@ bool App::loadMap(const std::string& mapFile) {
             player->setPosition(playerStart->position);
         }
         camera->setPosition(playerStart->position + glm::vec3(0.0f, 1.6f, 0.0f));
-        std::cout << "Player start position: " << playerStart->position.x << ", " 
-                  << playerStart->position.y << ", " << playerStart->position.z << std::endl;
+        prevCameraPosition = camera->getPosition();
+        SILIC2_LOG_INFO("Player start position: " << playerStart->position.x << ", " 
+                  << playerStart->position.y << ", " << playerStart->position.z);
     } else {
-        std::cout << "No player start found, using default position" << std::endl;
+        SILIC2_LOG_INFO("No player start found, using default position");
     }
     
     // Spawn enemies from map entities
@@ -442,10 +685,10 @@ bool App::loadMap(const std::string& mapFile) {
         groundParticles->setEmissionRate(effectsConfig.groundParticleEmissionRate);
         groundParticles->setFireIntensity(effectsConfig.groundParticleIntensity);
         groundParticles->setEnabled(true);
-        std::cout << "Ground particle system initialized with map floor data" << std::endl;
+        SILIC2_LOG_INFO("Ground particle system initialized with map floor data");
     } else if (groundParticles) {
         groundParticles->setEnabled(false);
-        std::cout << "Ground particle system disabled by config" << std::endl;
+        SILIC2_LOG_INFO("Ground particle system disabled by config");
     }
 
     // Build minimap geometry from the loaded map
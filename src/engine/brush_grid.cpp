@@ -0,0 +1,106 @@
+#include "engine/brush_grid.h"
+#include "engine/map.h"
+#include <algorithm>
+#include <cmath>
+
+namespace silic2 {
+
+void BrushGrid::clear() {
+    cellsX = cellsZ = 0;
+    cellStart.clear();
+    cellItems.clear();
+}
+
+void BrushGrid::cellRange(float minX, float minZ, float maxX, float maxZ,
+                          int& x0, int& z0, int& x1, int& z1) const {
+    float inv = 1.0f / cellSize;
+    x0 = std::clamp(static_cast<int>(std::floor((minX - origin.x) * inv)), 0, cellsX - 1);
+    z0 = std::clamp(static_cast<int>(std::floor((minZ - origin.y) * inv)), 0, cellsZ - 1);
+    x1 = std::clamp(static_cast<int>(std::floor((maxX - origin.x) * inv)), 0, cellsX - 1);
+    z1 = std::clamp(static_cast<int>(std::floor((maxZ - origin.y) * inv)), 0, cellsZ - 1);
+}
+
+void BrushGrid::build(const BrushBounds& bounds, float requestedCellSize) {
+    clear();
+
+    // World XZ extent of all solid brushes
+    bool any = false;
+    glm::vec2 worldMin(0.0f), worldMax(0.0f);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        glm::vec2 bMin(bounds.minX[i], bounds.minZ[i]);
+        glm::vec2 bMax(bounds.maxX[i], bounds.maxZ[i]);
+        if (!any) {
+            worldMin = bMin;
+            worldMax = bMax;
+            any = true;
+        } else {
+            worldMin = glm::min(worldMin, bMin);
+            worldMax = glm::max(worldMax, bMax);
+        }
+    }
+    if (!any) return;
+
+    // Grow cells on very large maps so the grid stays bounded
+    glm::vec2 extent = worldMax - worldMin;
+    float maxExtent = std::max(extent.x, extent.y);
+    cellSize = std::max(requestedCellSize, maxExtent / MAX_CELLS_PER_AXIS);
+    origin = worldMin;
+    cellsX = std::max(1, static_cast<int>(std::ceil(extent.x / cellSize)) + 1);
+    cellsZ = std::max(1, static_cast<int>(std::ceil(extent.y / cellSize)) + 1);
+    cellsX = std::min(cellsX, MAX_CELLS_PER_AXIS + 1);
+    cellsZ = std::min(cellsZ, MAX_CELLS_PER_AXIS + 1);
+
+    // Pass 1: count brushes per cell
+    size_t cellCount = static_cast<size_t>(cellsX) * cellsZ;
+    std::vector<uint32_t> counts(cellCount, 0);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        int x0, z0, x1, z1;
+        cellRange(bounds.minX[i], bounds.minZ[i], bounds.maxX[i], bounds.maxZ[i], x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++counts[static_cast<size_t>(z) * cellsX + x];
+    }
+
+    // Prefix sum into cell offsets
+    cellStart.assign(cellCount + 1, 0);
+    for (size_t c = 0; c < cellCount; ++c) {
+        cellStart[c + 1] = cellStart[c] + counts[c];
+    }
+
+    // Pass 2: scatter brush indices (ascending within each cell)
+    cellItems.resize(cellStart[cellCount]);
+    std::vector<uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        int x0, z0, x1, z1;
+        cellRange(bounds.minX[i], bounds.minZ[i], bounds.maxX[i], bounds.maxZ[i], x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                cellItems[cursor[static_cast<size_t>(z) * cellsX + x]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void BrushGrid::query(const AABB& box, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (cellStart.empty()) return;
+
+    int x0, z0, x1, z1;
+    cellRange(box.min.x, box.min.z, box.max.x, box.max.z, x0, z0, x1, z1);
+
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            size_t c = static_cast<size_t>(z) * cellsX + x;
+            out.insert(out.end(), cellItems.begin() + cellStart[c], cellItems.begin() + cellStart[c + 1]);
+        }
+    }
+
+    // A brush spanning several cells shows up once per cell
+    if (x0 != x1 || z0 != z1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+} // namespace silic2
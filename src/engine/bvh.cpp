@@ -0,0 +1,171 @@
+#include "engine/bvh.h"
+#include "engine/map.h"
+#include <algorithm>
+
+namespace silic2 {
+
+namespace {
+
+// Slab test of a segment against a node box, clipped to [0, tLimit]
+bool segmentEntersBox(const glm::vec3& bMin, const glm::vec3& bMax,
+                      const glm::vec3& start, const glm::vec3& invD,
+                      float tLimit, float& tEnter) {
+    glm::vec3 t1 = (bMin - start) * invD;
+    glm::vec3 t2 = (bMax - start) * invD;
+    glm::vec3 tNear = glm::min(t1, t2);
+    glm::vec3 tFar = glm::max(t1, t2);
+
+    tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tLimit));
+    return tEnter <= tExit;
+}
+
+// Reciprocal direction; zero components become huge values so the slab math
+// never produces NaN (0 * inf) for axis-parallel segments.
+glm::vec3 safeInverse(const glm::vec3& d) {
+    glm::vec3 inv;
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(d[i]) < 1e-8f) {
+            inv[i] = d[i] < 0.0f ? -1e30f : 1e30f;
+        } else {
+            inv[i] = 1.0f / d[i];
+        }
+    }
+    return inv;
+}
+
+} // namespace
+
+void BrushBVH::clear() {
+    nodes.clear();
+    brushIndices.clear();
+    leafBoxes.clear();
+}
+
+void BrushBVH::build(const BrushBounds& bounds) {
+    clear();
+
+    std::vector<BuildItem> items;
+    items.reserve(bounds.size());
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        AABB box = bounds.getAABB(i);
+        items.push_back({ box, box.getCenter(), static_cast<uint32_t>(i) });
+    }
+
+    if (items.empty()) return;
+
+    nodes.reserve(items.size() * 2);
+    nodes.push_back({ glm::vec3(0.0f), glm::vec3(0.0f), 0, static_cast<uint32_t>(items.size()) });
+    subdivide(0, items);
+
+    // Items were partitioned in place; copy them out in tree order
+    brushIndices.reserve(items.size());
+    leafBoxes.reserve(items.size());
+    for (const auto& item : items) {
+        brushIndices.push_back(item.brushIndex);
+        leafBoxes.push_back(item.box);
+    }
+}
+
+void BrushBVH::subdivide(uint32_t nodeIndex, std::vector<BuildItem>& items) {
+    uint32_t first = nodes[nodeIndex].leftOrFirst;
+    uint32_t count = nodes[nodeIndex].count;
+
+    // Node bounds and centroid bounds over this node's items
+    glm::vec3 nodeMin = items[first].box.min, nodeMax = items[first].box.max;
+    glm::vec3 centroidMin = items[first].centroid, centroidMax = items[first].centroid;
+    for (uint32_t i = first; i < first + count; ++i) {
+        nodeMin = glm::min(nodeMin, items[i].box.min);
+        nodeMax = glm::max(nodeMax, items[i].box.max);
+        centroidMin = glm::min(centroidMin, items[i].centroid);
+        centroidMax = glm::max(centroidMax, items[i].centroid);
+    }
+    nodes[nodeIndex].min = nodeMin;
+    nodes[nodeIndex].max = nodeMax;
+
+    if (count <= MAX_LEAF_SIZE) return;
+
+    // Split along the longest centroid axis at the median
+    glm::vec3 extent = centroidMax - centroidMin;
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+    if (extent[axis] <= 0.0f) return;  // All centroids coincide; keep as one leaf
+
+    uint32_t half = count / 2;
+    auto begin = items.begin() + first;
+    std::nth_element(begin, begin + half, begin + count,
+        [axis](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+    uint32_t leftIndex = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({ glm::vec3(0.0f), glm::vec3(0.0f), first, half });
+    nodes.push_back({ glm::vec3(0.0f), glm::vec3(0.0f), first + half, count - half });
+
+    nodes[nodeIndex].leftOrFirst = leftIndex;
+    nodes[nodeIndex].count = 0;
+
+    subdivide(leftIndex, items);
+    subdivide(leftIndex + 1, items);
+}
+
+SegmentHit BrushBVH::intersectSegment(const glm::vec3& start, const glm::vec3& end) const {
+    SegmentHit best;
+    if (nodes.empty()) return best;
+
+    glm::vec3 invD = safeInverse(end - start);
+
+    uint32_t stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+
+        float tEnter;
+        if (!segmentEntersBox(node.min, node.max, start, invD, best.t, tEnter)) continue;
+
+        if (node.count > 0) {
+            for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i) {
+                float t;
+                glm::vec3 normal;
+                if (CollisionSystem::intersectSegmentAABB(start, end, leafBoxes[i], t, normal) &&
+                    (!best.hit || t < best.t)) {
+                    best.hit = true;
+                    best.t = t;
+                    best.normal = normal;
+                    best.brushIndex = brushIndices[i];
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first so later boxes get pruned by best.t
+        uint32_t left = node.leftOrFirst;
+        uint32_t right = left + 1;
+        float tLeft, tRight;
+        bool hitLeft = segmentEntersBox(nodes[left].min, nodes[left].max, start, invD, best.t, tLeft);
+        bool hitRight = segmentEntersBox(nodes[right].min, nodes[right].max, start, invD, best.t, tRight);
+
+        if (hitLeft && hitRight) {
+            if (tLeft <= tRight) {
+                stack[stackSize++] = right;
+                stack[stackSize++] = left;
+            } else {
+                stack[stackSize++] = left;
+                stack[stackSize++] = right;
+            }
+        } else if (hitLeft) {
+            stack[stackSize++] = left;
+        } else if (hitRight) {
+            stack[stackSize++] = right;
+        }
+    }
+
+    if (best.hit) {
+        best.point = start + (end - start) * best.t;
+    }
+    return best;
+}
+
+} // namespace silic2
@@ -1,6 +1,5 @@
 #include "engine/camera.h"
 #include "engine/game_config.h"
-#include <GLFW/glfw3.h>
 
 namespace silic2 {
 
@@ -14,26 +13,6 @@ Camera::Camera(glm::vec3 position)
     updateCameraVectors();
 }
 
-void Camera::processKeyboard(GLFWwindow* window, float deltaTime) {
-    const auto& config = GameConfig::getInstance().player;
-    float velocity = config.moveSpeed * deltaTime;
-    
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        position += velocity * front;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        position -= velocity * front;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        position -= glm::normalize(glm::cross(front, up)) * velocity;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        position += glm::normalize(glm::cross(front, up)) * velocity;
-    
-    // Vertical movement
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
-        position += velocity * up;
-    if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
-        position -= velocity * up;
-}
-
 void Camera::processMouseMovement(float xoffset, float yoffset, bool constrainPitch) {
     yaw += xoffset;
     pitch += yoffset;
@@ -67,6 +46,10 @@ glm::mat4 Camera::getViewMatrix() const {
     return glm::lookAt(position, position + front, up);
 }
 
+glm::mat4 Camera::getViewMatrix(const glm::vec3& eye) const {
+    return glm::lookAt(eye, eye + front, up);
+}
+
 glm::mat4 Camera::getProjectionMatrix(float aspectRatio) const {
     const auto& config = GameConfig::getInstance().render;
     return glm::perspective(glm::radians(fov), aspectRatio, config.nearPlane, config.farPlane);
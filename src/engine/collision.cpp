@@ -1,9 +1,225 @@
 #include "engine/collision.h"
 #include <algorithm>
 #include <limits>
+#include <cmath>
+
+// SSE2 is baseline on x86-64; the AVX2 kernel is compiled with a target
+// attribute and only selected when the CPU reports support for it.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define SILIC2_COLLISION_SIMD 1
+#include <immintrin.h>
+#endif
 
 namespace silic2 {
 
+namespace {
+
+// Per-segment constants shared by every box kernel
+struct SegmentSetup {
+    float start[3];
+    float invD[3];
+    bool parallel[3];
+};
+
+SegmentSetup makeSegmentSetup(float sx, float sy, float sz, float ex, float ey, float ez) {
+    SegmentSetup seg;
+    const float start[3] = {sx, sy, sz};
+    const float d[3] = {ex - sx, ey - sy, ez - sz};
+    for (int a = 0; a < 3; ++a) {
+        seg.start[a] = start[a];
+        // Parallel to this slab: the start must already be inside it
+        seg.parallel[a] = std::abs(d[a]) < 1e-8f;
+        seg.invD[a] = seg.parallel[a] ? 0.0f : 1.0f / d[a];
+    }
+    return seg;
+}
+
+// Reference kernel: boxes [first, count). Strict '<' keeps the lowest index on ties.
+void scanBoxesScalar(const SegmentSetup& seg, const AABBBatch& boxes, size_t first,
+                     int32_t& best, float& bestT) {
+    const float* mins[3] = {boxes.minX.data(), boxes.minY.data(), boxes.minZ.data()};
+    const float* maxs[3] = {boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data()};
+    const size_t count = boxes.size();
+
+    for (size_t i = first; i < count; ++i) {
+        float tMin = 0.0f, tMax = 1.0f;
+        bool inside = true;
+        for (int a = 0; a < 3; ++a) {
+            if (seg.parallel[a]) {
+                inside = inside && seg.start[a] >= mins[a][i] && seg.start[a] <= maxs[a][i];
+            } else {
+                float t1 = (mins[a][i] - seg.start[a]) * seg.invD[a];
+                float t2 = (maxs[a][i] - seg.start[a]) * seg.invD[a];
+                tMin = std::max(tMin, std::min(t1, t2));
+                tMax = std::min(tMax, std::max(t1, t2));
+            }
+        }
+        if (inside && tMin <= tMax && tMin < bestT) {
+            best = static_cast<int32_t>(i);
+            bestT = tMin;
+        }
+    }
+}
+
+#ifdef SILIC2_COLLISION_SIMD
+
+// Folds per-lane winners into best/bestT: smallest t, then lowest index
+void reduceLanes(const float* laneT, const int32_t* laneIdx, int lanes, int32_t& best, float& bestT) {
+    for (int l = 0; l < lanes; ++l) {
+        if (laneIdx[l] < 0) continue;
+        if (laneT[l] < bestT || (laneT[l] == bestT && laneIdx[l] < best)) {
+            best = laneIdx[l];
+            bestT = laneT[l];
+        }
+    }
+}
+
+// 4 boxes per iteration; returns how many boxes were consumed
+size_t scanBoxesSSE(const SegmentSetup& seg, const AABBBatch& boxes, int32_t& best, float& bestT) {
+    const float* mins[3] = {boxes.minX.data(), boxes.minY.data(), boxes.minZ.data()};
+    const float* maxs[3] = {boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data()};
+    const size_t count = boxes.size() & ~size_t(3);
+
+    __m128 laneBestT = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128i laneBestIdx = _mm_set1_epi32(-1);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i step = _mm_set1_epi32(4);
+
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 tMin = _mm_setzero_ps();
+        __m128 tMax = _mm_set1_ps(1.0f);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int a = 0; a < 3; ++a) {
+            __m128 bMin = _mm_loadu_ps(mins[a] + i);
+            __m128 bMax = _mm_loadu_ps(maxs[a] + i);
+            __m128 s = _mm_set1_ps(seg.start[a]);
+            if (seg.parallel[a]) {
+                inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(s, bMin), _mm_cmple_ps(s, bMax)));
+            } else {
+                __m128 inv = _mm_set1_ps(seg.invD[a]);
+                __m128 t1 = _mm_mul_ps(_mm_sub_ps(bMin, s), inv);
+                __m128 t2 = _mm_mul_ps(_mm_sub_ps(bMax, s), inv);
+                tMin = _mm_max_ps(tMin, _mm_min_ps(t1, t2));
+                tMax = _mm_min_ps(tMax, _mm_max_ps(t1, t2));
+            }
+        }
+        __m128 better = _mm_and_ps(_mm_and_ps(inside, _mm_cmple_ps(tMin, tMax)),
+                                   _mm_cmplt_ps(tMin, laneBestT));
+        laneBestT = _mm_or_ps(_mm_and_ps(better, tMin), _mm_andnot_ps(better, laneBestT));
+        __m128i betterI = _mm_castps_si128(better);
+        laneBestIdx = _mm_or_si128(_mm_and_si128(betterI, index), _mm_andnot_si128(betterI, laneBestIdx));
+        index = _mm_add_epi32(index, step);
+    }
+
+    alignas(16) float laneT[4];
+    alignas(16) int32_t laneIdx[4];
+    _mm_store_ps(laneT, laneBestT);
+    _mm_store_si128(reinterpret_cast<__m128i*>(laneIdx), laneBestIdx);
+    reduceLanes(laneT, laneIdx, 4, best, bestT);
+    return count;
+}
+
+// 8 boxes per iteration; returns how many boxes were consumed
+__attribute__((target("avx2")))
+size_t scanBoxesAVX2(const SegmentSetup& seg, const AABBBatch& boxes, int32_t& best, float& bestT) {
+    const float* mins[3] = {boxes.minX.data(), boxes.minY.data(), boxes.minZ.data()};
+    const float* maxs[3] = {boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data()};
+    const size_t count = boxes.size() & ~size_t(7);
+
+    __m256 laneBestT = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256i laneBestIdx = _mm256_set1_epi32(-1);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    for (size_t i = 0; i < count; i += 8) {
+        __m256 tMin = _mm256_setzero_ps();
+        __m256 tMax = _mm256_set1_ps(1.0f);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int a = 0; a < 3; ++a) {
+            __m256 bMin = _mm256_loadu_ps(mins[a] + i);
+            __m256 bMax = _mm256_loadu_ps(maxs[a] + i);
+            __m256 s = _mm256_set1_ps(seg.start[a]);
+            if (seg.parallel[a]) {
+                inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(s, bMin, _CMP_GE_OQ),
+                                                             _mm256_cmp_ps(s, bMax, _CMP_LE_OQ)));
+            } else {
+                __m256 inv = _mm256_set1_ps(seg.invD[a]);
+                __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(bMin, s), inv);
+                __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(bMax, s), inv);
+                tMin = _mm256_max_ps(tMin, _mm256_min_ps(t1, t2));
+                tMax = _mm256_min_ps(tMax, _mm256_max_ps(t1, t2));
+            }
+        }
+        __m256 better = _mm256_and_ps(_mm256_and_ps(inside, _mm256_cmp_ps(tMin, tMax, _CMP_LE_OQ)),
+                                      _mm256_cmp_ps(tMin, laneBestT, _CMP_LT_OQ));
+        laneBestT = _mm256_blendv_ps(laneBestT, tMin, better);
+        laneBestIdx = _mm256_blendv_epi8(laneBestIdx, index, _mm256_castps_si256(better));
+        index = _mm256_add_epi32(index, step);
+    }
+
+    alignas(32) float laneT[8];
+    alignas(32) int32_t laneIdx[8];
+    _mm256_store_ps(laneT, laneBestT);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneIdx), laneBestIdx);
+    reduceLanes(laneT, laneIdx, 8, best, bestT);
+    return count;
+}
+
+bool cpuHasAVX2() {
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+}
+
+#endif // SILIC2_COLLISION_SIMD
+
+int32_t scanBoxes(const SegmentSetup& seg, const AABBBatch& boxes, float& tHit) {
+    int32_t best = -1;
+    float bestT = std::numeric_limits<float>::infinity();
+    size_t done = 0;
+#ifdef SILIC2_COLLISION_SIMD
+    done = cpuHasAVX2() ? scanBoxesAVX2(seg, boxes, best, bestT)
+                        : scanBoxesSSE(seg, boxes, best, bestT);
+#endif
+    scanBoxesScalar(seg, boxes, done, best, bestT);
+    tHit = bestT;
+    return best;
+}
+
+} // namespace
+
+void AABBBatch::clear() {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+}
+
+void AABBBatch::reserve(size_t count) {
+    minX.reserve(count); minY.reserve(count); minZ.reserve(count);
+    maxX.reserve(count); maxY.reserve(count); maxZ.reserve(count);
+}
+
+void AABBBatch::push(const AABB& box) {
+    minX.push_back(box.min.x); minY.push_back(box.min.y); minZ.push_back(box.min.z);
+    maxX.push_back(box.max.x); maxY.push_back(box.max.y); maxZ.push_back(box.max.z);
+}
+
+void SegmentBatch::clear() {
+    startX.clear(); startY.clear(); startZ.clear();
+    endX.clear(); endY.clear(); endZ.clear();
+}
+
+void SegmentBatch::reserve(size_t count) {
+    startX.reserve(count); startY.reserve(count); startZ.reserve(count);
+    endX.reserve(count); endY.reserve(count); endZ.reserve(count);
+}
+
+void SegmentBatch::push(const glm::vec3& start, const glm::vec3& end) {
+    startX.push_back(start.x); startY.push_back(start.y); startZ.push_back(start.z);
+    endX.push_back(end.x); endY.push_back(end.y); endZ.push_back(end.z);
+}
+
 bool CollisionSystem::checkAABB(const AABB& a, const AABB& b) {
     return a.intersects(b);
 }
@@ -11,35 +227,54 @@ bool CollisionSystem::checkAABB(const AABB& a, const AABB& b) {
 CollisionResult CollisionSystem::sweepAABB(const AABB& movingBox, const glm::vec3& velocity, 
                                           const AABB& staticBox, float deltaTime) {
     CollisionResult result;
+    glm::vec3 d = velocity * deltaTime;
+    
+    // Slab test of the static box against the moving box's faces (Minkowski
+    // difference), tracking the last axis to start overlapping
+    float tEnter = -std::numeric_limits<float>::infinity();
+    float tExit = std::numeric_limits<float>::infinity();
+    int hitAxis = -1;
     
-    // Expand static box size (Minkowski sum)
-    AABB expandedBox;
-    expandedBox.min = staticBox.min - movingBox.getSize() * 0.5f;
-    expandedBox.max = staticBox.max + movingBox.getSize() * 0.5f;
-    
-    // Create ray from moving box center
-    glm::vec3 center = movingBox.getCenter();
-    Ray ray(center, velocity);
-    
-    // Ray vs expanded box collision detection
-    result = raycastAABB(ray, expandedBox, glm::length(velocity) * deltaTime);
-    
-    if (result.collided) {
-        // Calculate actual collision point (considering box size)
-        glm::vec3 halfSize = movingBox.getSize() * 0.5f;
-        
-        // Adjust collision point based on normal direction
-        if (std::abs(result.normal.x) > 0.5f) {
-            result.point.x += halfSize.x * -result.normal.x;
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(d[i]) < 1e-8f) {
+            // Not moving on this axis: must already overlap it (touching does not count)
+            if (movingBox.max[i] <= staticBox.min[i] || movingBox.min[i] >= staticBox.max[i]) {
+                return result;
+            }
+            continue;
         }
-        if (std::abs(result.normal.y) > 0.5f) {
-            result.point.y += halfSize.y * -result.normal.y;
+        float invD = 1.0f / d[i];
+        float t0, t1;
+        if (d[i] > 0.0f) {
+            t0 = (staticBox.min[i] - movingBox.max[i]) * invD;
+            t1 = (staticBox.max[i] - movingBox.min[i]) * invD;
+        } else {
+            t0 = (staticBox.max[i] - movingBox.min[i]) * invD;
+            t1 = (staticBox.min[i] - movingBox.max[i]) * invD;
         }
-        if (std::abs(result.normal.z) > 0.5f) {
-            result.point.z += halfSize.z * -result.normal.z;
+        if (t0 > tEnter) {
+            tEnter = t0;
+            hitAxis = i;
         }
+        tExit = std::min(tExit, t1);
+    }
+    
+    // Already overlapping on every moving axis, grazing, separating, or out of reach this step
+    if (hitAxis < 0 || tEnter >= tExit || tExit <= 0.0f || tEnter > 1.0f) return result;
+    
+    if (tEnter < 0.0f) {
+        // Started inside: only treat it as contact when within rounding of the face,
+        // so a box resting against a surface cannot creep into it. Deeper overlaps
+        // are left alone rather than snagging on them.
+        if (-tEnter * std::abs(d[hitAxis]) > SWEEP_CONTACT_TOLERANCE) return result;
+        tEnter = 0.0f;
     }
     
+    result.collided = true;
+    result.distance = tEnter * deltaTime;
+    result.point = movingBox.getCenter() + d * tEnter;
+    result.normal = glm::vec3(0.0f);
+    result.normal[hitAxis] = d[hitAxis] > 0.0f ? -1.0f : 1.0f;
     return result;
 }
 
@@ -85,6 +320,67 @@ CollisionResult CollisionSystem::raycastAABB(const Ray& ray, const AABB& box, fl
     return result;
 }
 
+bool CollisionSystem::intersectSegmentAABB(const glm::vec3& start, const glm::vec3& end, const AABB& box,
+                                           float& tHit, glm::vec3& normal) {
+    glm::vec3 d = end - start;
+    float tMin = 0.0f, tMax = 1.0f;
+    int hitAxis = -1;
+    
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(d[i]) < 1e-8f) {
+            // Parallel to this slab: must already be inside it
+            if (start[i] < box.min[i] || start[i] > box.max[i]) return false;
+        } else {
+            float invD = 1.0f / d[i];
+            float t1 = (box.min[i] - start[i]) * invD;
+            float t2 = (box.max[i] - start[i]) * invD;
+            if (t1 > t2) std::swap(t1, t2);
+            if (t1 >= tMin) {
+                tMin = t1;
+                hitAxis = i;
+            }
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax) return false;
+        }
+    }
+    
+    tHit = tMin;
+    normal = glm::vec3(0.0f);
+    if (hitAxis < 0) {
+        // Started inside the box: report the face opposing the dominant travel axis
+        hitAxis = 1;
+        if (std::abs(d.x) >= std::abs(d.y) && std::abs(d.x) >= std::abs(d.z)) hitAxis = 0;
+        else if (std::abs(d.z) >= std::abs(d.y)) hitAxis = 2;
+    }
+    normal[hitAxis] = d[hitAxis] > 0.0f ? -1.0f : 1.0f;
+    return true;
+}
+
+void CollisionSystem::intersectSegmentsAABBs(const SegmentBatch& segments, const AABBBatch& boxes,
+                                             std::vector<int32_t>& hitBox, std::vector<float>& hitT) {
+    const size_t count = segments.size();
+    hitBox.assign(count, -1);
+    hitT.assign(count, 1.0f);
+    if (boxes.size() == 0) return;
+    
+    for (size_t s = 0; s < count; ++s) {
+        SegmentSetup seg = makeSegmentSetup(segments.startX[s], segments.startY[s], segments.startZ[s],
+                                            segments.endX[s], segments.endY[s], segments.endZ[s]);
+        float t;
+        int32_t box = scanBoxes(seg, boxes, t);
+        if (box >= 0) {
+            hitBox[s] = box;
+            hitT[s] = t;
+        }
+    }
+}
+
+int32_t CollisionSystem::intersectSegmentAABBs(const glm::vec3& start, const glm::vec3& end,
+                                               const AABBBatch& boxes, float& tHit) {
+    SegmentSetup seg = makeSegmentSetup(start.x, start.y, start.z, end.x, end.y, end.z);
+    return scanBoxes(seg, boxes, tHit);
+}
+
 glm::vec3 CollisionSystem::getAABBPenetration(const AABB& a, const AABB& b) {
     if (!a.intersects(b)) {
         return glm::vec3(0.0f);
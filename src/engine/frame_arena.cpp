@@ -0,0 +1,38 @@
+#include "engine/frame_arena.h"
+#include <algorithm>
+
+namespace silic2 {
+
+FrameArena::FrameArena(size_t capacity)
+    : block(new unsigned char[capacity]), capacity(capacity) {
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    uintptr_t aligned = (base + used + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    size_t offset = static_cast<size_t>(aligned - base);
+    if (offset + bytes <= capacity) {
+        used = offset + bytes;
+        return block.get() + offset;
+    }
+
+    // Out of room this frame: spill to the heap until the next reset
+    overflow.emplace_back(new unsigned char[bytes + alignment]);
+    overflowBytes += bytes + alignment;
+    uintptr_t spill = reinterpret_cast<uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void*>((spill + alignment - 1) & ~(uintptr_t(alignment) - 1));
+}
+
+void FrameArena::reset() {
+    peak = std::max(peak, used + overflowBytes);
+    if (!overflow.empty()) {
+        // Grow once so frames like this one fit without spilling
+        overflow.clear();
+        capacity = std::max(capacity * 2, peak);
+        block.reset(new unsigned char[capacity]);
+    }
+    used = 0;
+    overflowBytes = 0;
+}
+
+} // namespace silic2
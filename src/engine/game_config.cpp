@@ -1,6 +1,6 @@
 #include "engine/game_config.h"
 #include "engine/simple_json.h"
-#include <iostream>
+#include "engine/log.h"
 #include <fstream>
 
 namespace silic2 {
@@ -13,7 +13,7 @@ GameConfig& GameConfig::getInstance() {
 bool GameConfig::loadFromFile(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Could not open config file: " << filename << std::endl;
+        SILIC2_LOG_ERROR("Could not open config file: " << filename);
         return false;
     }
     
@@ -24,7 +24,7 @@ bool GameConfig::loadFromFile(const std::string& filename) {
     try {
         SimpleJson json = SimpleJson::parse(content);
         if (json.isNull()) {
-            std::cerr << "Failed to parse config JSON" << std::endl;
+            SILIC2_LOG_ERROR("Failed to parse config JSON");
             return false;
         }
         
@@ -48,6 +48,16 @@ bool GameConfig::loadFromFile(const std::string& filename) {
             render.enableDepthTest = renderObj.getBool("enableDepthTest", render.enableDepthTest);
         }
         
+        // Parse simulation config
+        if (json.hasKey("simulation")) {
+            auto simulationObj = json["simulation"];
+            simulation.tickRate = (float)simulationObj.getNumber("tickRate", simulation.tickRate);
+            simulation.maxTicksPerFrame = (int)simulationObj.getNumber("maxTicksPerFrame", simulation.maxTicksPerFrame);
+            simulation.maxFrameTime = (float)simulationObj.getNumber("maxFrameTime", simulation.maxFrameTime);
+            simulation.interpolate = simulationObj.getBool("interpolate", simulation.interpolate);
+            simulation.workerThreads = (int)simulationObj.getNumber("workerThreads", simulation.workerThreads);
+        }
+        
         // Parse player config
         if (json.hasKey("player")) {
             auto playerObj = json["player"];
@@ -84,12 +94,14 @@ bool GameConfig::loadFromFile(const std::string& filename) {
             effects.enableGroundParticles = effectsObj.getBool("enableGroundParticles", effects.enableGroundParticles);
             effects.groundParticleIntensity = (float)effectsObj.getNumber("groundParticleIntensity", effects.groundParticleIntensity);
             effects.groundParticleEmissionRate = (float)effectsObj.getNumber("groundParticleEmissionRate", effects.groundParticleEmissionRate);
+            effects.gpuParticles = effectsObj.getBool("gpuParticles", effects.gpuParticles);
+            effects.groundParticleCollision = effectsObj.getBool("groundParticleCollision", effects.groundParticleCollision);
         }
         
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Error parsing config: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Error parsing config: " << e.what());
         return false;
     }
 }
@@ -98,7 +110,7 @@ bool GameConfig::saveToFile(const std::string& filename) const {
     try {
         std::ofstream file(filename);
         if (!file.is_open()) {
-            std::cerr << "Could not create config file: " << filename << std::endl;
+            SILIC2_LOG_ERROR("Could not create config file: " << filename);
             return false;
         }
         
@@ -119,6 +131,14 @@ bool GameConfig::saveToFile(const std::string& filename) const {
         file << "    \"enableDepthTest\": " << (render.enableDepthTest ? "true" : "false") << "\n";
         file << "  },\n";
         
+        file << "  \"simulation\": {\n";
+        file << "    \"tickRate\": " << simulation.tickRate << ",\n";
+        file << "    \"maxTicksPerFrame\": " << simulation.maxTicksPerFrame << ",\n";
+        file << "    \"maxFrameTime\": " << simulation.maxFrameTime << ",\n";
+        file << "    \"interpolate\": " << (simulation.interpolate ? "true" : "false") << ",\n";
+        file << "    \"workerThreads\": " << simulation.workerThreads << "\n";
+        file << "  },\n";
+        
         file << "  \"player\": {\n";
         file << "    \"moveSpeed\": " << player.moveSpeed << ",\n";
         file << "    \"sprintSpeed\": " << player.sprintSpeed << ",\n";
@@ -148,7 +168,9 @@ bool GameConfig::saveToFile(const std::string& filename) const {
         file << "  \"effects\": {\n";
         file << "    \"enableGroundParticles\": " << (effects.enableGroundParticles ? "true" : "false") << ",\n";
         file << "    \"groundParticleIntensity\": " << effects.groundParticleIntensity << ",\n";
-        file << "    \"groundParticleEmissionRate\": " << effects.groundParticleEmissionRate << "\n";
+        file << "    \"groundParticleEmissionRate\": " << effects.groundParticleEmissionRate << ",\n";
+        file << "    \"gpuParticles\": " << (effects.gpuParticles ? "true" : "false") << ",\n";
+        file << "    \"groundParticleCollision\": " << (effects.groundParticleCollision ? "true" : "false") << "\n";
         file << "  }\n";
         file << "}\n";
         
@@ -156,7 +178,7 @@ bool GameConfig::saveToFile(const std::string& filename) const {
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Error saving config: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Error saving config: " << e.what());
         return false;
     }
 }
@@ -164,6 +186,7 @@ bool GameConfig::saveToFile(const std::string& filename) const {
 void GameConfig::resetToDefaults() {
     window = WindowConfig{};
     render = RenderConfig{};
+    simulation = SimulationConfig{};
     player = PlayerConfig{};
     camera = CameraConfig{};
     effects = EffectsConfig{};
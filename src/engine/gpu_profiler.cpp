@@ -0,0 +1,107 @@
+#include "engine/gpu_profiler.h"
+#include "engine/log.h"
+
+namespace silic2 {
+
+GpuProfiler::~GpuProfiler() {
+    if (!supported) return;
+    for (auto& set : sets) {
+        glDeleteQueries(static_cast<GLsizei>(set.queries.size()), set.queries.data());
+    }
+}
+
+bool GpuProfiler::init() {
+    if (!GLAD_GL_VERSION_3_3) {
+        SILIC2_LOG_ERROR("GPU profiler: GL 3.3 timer queries unavailable");
+        return false;
+    }
+    // Some implementations expose the query but with a zero-bit counter
+    GLint counterBits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &counterBits);
+    if (counterBits == 0) {
+        SILIC2_LOG_ERROR("GPU profiler: GL_TIME_ELAPSED has no counter bits");
+        return false;
+    }
+
+    for (auto& set : sets) {
+        glGenQueries(static_cast<GLsizei>(set.queries.size()), set.queries.data());
+    }
+    supported = true;
+    return true;
+}
+
+void GpuProfiler::beginFrame() {
+    if (!supported) return;
+
+    // The set we are about to reuse was issued FRAMES_IN_FLIGHT frames ago
+    current = frameCounter % FRAMES_IN_FLIGHT;
+    QuerySet& set = sets[current];
+    if (set.pending && !collect(set)) {
+        ++skippedFrames;
+    }
+    set.pending = false;
+    set.issued.fill(false);
+    set.frame = frameCounter;
+}
+
+void GpuProfiler::beginPass(GpuPass pass) {
+    if (!supported || activePass >= 0) return;
+    size_t index = static_cast<size_t>(pass);
+    QuerySet& set = sets[current];
+    glBeginQuery(GL_TIME_ELAPSED, set.queries[index]);
+    set.issued[index] = true;
+    activePass = static_cast<int>(index);
+}
+
+void GpuProfiler::endPass() {
+    if (!supported || activePass < 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    activePass = -1;
+}
+
+void GpuProfiler::endFrame() {
+    if (!supported) return;
+    endPass();
+
+    QuerySet& set = sets[current];
+    for (bool issued : set.issued) set.pending = set.pending || issued;
+    ++frameCounter;
+}
+
+bool GpuProfiler::collect(QuerySet& set) {
+    // Only read once every result is ready; GL_QUERY_RESULT would block otherwise
+    for (size_t i = 0; i < set.queries.size(); ++i) {
+        if (!set.issued[i]) continue;
+        GLint available = 0;
+        glGetQueryObjectiv(set.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;
+    }
+
+    GpuFrameStats stats;
+    stats.frame = set.frame;
+    stats.valid = true;
+    for (size_t i = 0; i < set.queries.size(); ++i) {
+        if (!set.issued[i]) continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(set.queries[i], GL_QUERY_RESULT, &ns);
+        stats.passMs[i] = static_cast<float>(ns) * 1e-6f;
+        stats.totalMs += stats.passMs[i];
+    }
+    latest = stats;
+    return true;
+}
+
+const char* GpuProfiler::passName(GpuPass pass) {
+    switch (pass) {
+        case GpuPass::MAP:        return "map";
+        case GpuPass::BULLETS:    return "bullets";
+        case GpuPass::ENEMIES:    return "enemies";
+        case GpuPass::PARTICLES:  return "particles";
+        case GpuPass::PIXEL_POST: return "pixel post";
+        case GpuPass::HUD:        return "hud";
+        case GpuPass::COUNT:      break;
+    }
+    return "?";
+}
+
+} // namespace silic2
@@ -0,0 +1,121 @@
+#include "engine/heightfield.h"
+#include "engine/map.h"
+#include <algorithm>
+#include <cmath>
+
+namespace silic2 {
+
+void Heightfield::clear() {
+    cellsX = cellsZ = 0;
+    cellStart.clear();
+    entries.clear();
+}
+
+void Heightfield::cellRange(float minX, float minZ, float maxX, float maxZ,
+                            int& x0, int& z0, int& x1, int& z1) const {
+    float inv = 1.0f / cellSize;
+    x0 = std::clamp(static_cast<int>(std::floor((minX - origin.x) * inv)), 0, cellsX - 1);
+    z0 = std::clamp(static_cast<int>(std::floor((minZ - origin.y) * inv)), 0, cellsZ - 1);
+    x1 = std::clamp(static_cast<int>(std::floor((maxX - origin.x) * inv)), 0, cellsX - 1);
+    z1 = std::clamp(static_cast<int>(std::floor((maxZ - origin.y) * inv)), 0, cellsZ - 1);
+}
+
+void Heightfield::build(const BrushBounds& bounds, float requestedCellSize) {
+    clear();
+
+    // Every solid brush top is walkable: the ground checks this replaces accept
+    // any brush, and some shipped maps wind their floor quads as ceilings.
+    bool any = false;
+    glm::vec2 worldMin(0.0f), worldMax(0.0f);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        glm::vec2 bMin(bounds.minX[i], bounds.minZ[i]);
+        glm::vec2 bMax(bounds.maxX[i], bounds.maxZ[i]);
+        if (!any) {
+            worldMin = bMin;
+            worldMax = bMax;
+            any = true;
+        } else {
+            worldMin = glm::min(worldMin, bMin);
+            worldMax = glm::max(worldMax, bMax);
+        }
+    }
+    if (!any) return;
+
+    // Grow cells on very large maps so the grid stays bounded
+    glm::vec2 extent = worldMax - worldMin;
+    float maxExtent = std::max(extent.x, extent.y);
+    cellSize = std::max(requestedCellSize, maxExtent / MAX_CELLS_PER_AXIS);
+    origin = worldMin;
+    cellsX = std::min(std::max(1, static_cast<int>(std::ceil(extent.x / cellSize)) + 1), MAX_CELLS_PER_AXIS + 1);
+    cellsZ = std::min(std::max(1, static_cast<int>(std::ceil(extent.y / cellSize)) + 1), MAX_CELLS_PER_AXIS + 1);
+
+    // Pass 1: count brush tops per cell
+    size_t cellCount = static_cast<size_t>(cellsX) * cellsZ;
+    std::vector<uint32_t> counts(cellCount, 0);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        int x0, z0, x1, z1;
+        cellRange(bounds.minX[i], bounds.minZ[i], bounds.maxX[i], bounds.maxZ[i], x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++counts[static_cast<size_t>(z) * cellsX + x];
+    }
+
+    cellStart.assign(cellCount + 1, 0);
+    for (size_t c = 0; c < cellCount; ++c) {
+        cellStart[c + 1] = cellStart[c] + counts[c];
+    }
+
+    // Pass 2: scatter, then sort each cell by height
+    entries.resize(cellStart[cellCount]);
+    std::vector<uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        Entry entry{bounds.maxY[i], bounds.minY[i],
+                    bounds.minX[i], bounds.minZ[i], bounds.maxX[i], bounds.maxZ[i]};
+        int x0, z0, x1, z1;
+        cellRange(bounds.minX[i], bounds.minZ[i], bounds.maxX[i], bounds.maxZ[i], x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                entries[cursor[static_cast<size_t>(z) * cellsX + x]++] = entry;
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        std::sort(entries.begin() + cellStart[c], entries.begin() + cellStart[c + 1],
+                  [](const Entry& a, const Entry& b) { return a.top < b.top; });
+    }
+}
+
+bool Heightfield::findGround(const AABB& probe, float maxTop, float& groundY) const {
+    if (cellStart.empty()) return false;
+
+    int x0, z0, x1, z1;
+    cellRange(probe.min.x, probe.min.z, probe.max.x, probe.max.z, x0, z0, x1, z1);
+
+    bool found = false;
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            size_t c = static_cast<size_t>(z) * cellsX + x;
+            auto first = entries.begin() + cellStart[c];
+            auto last = entries.begin() + cellStart[c + 1];
+
+            // Walk down from the highest top <= maxTop until tops drop below the probe
+            auto it = std::upper_bound(first, last, maxTop,
+                                       [](float value, const Entry& e) { return value < e.top; });
+            while (it != first) {
+                --it;
+                if (it->top < probe.min.y || (found && it->top <= groundY)) break;
+                if (it->bottom <= probe.max.y &&
+                    it->minX <= probe.max.x && it->maxX >= probe.min.x &&
+                    it->minZ <= probe.max.z && it->maxZ >= probe.min.z) {
+                    groundY = it->top;
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+} // namespace silic2
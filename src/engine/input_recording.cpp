@@ -0,0 +1,183 @@
+#include "engine/input_recording.h"
+#include "engine/log.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace silic2 {
+
+namespace {
+
+constexpr char     MAGIC[4] = {'S', '2', 'I', 'R'};
+constexpr uint32_t VERSION  = 1;
+
+// Record bits
+enum : uint16_t {
+    BIT_FORWARD     = 1 << 0,
+    BIT_BACK        = 1 << 1,
+    BIT_LEFT        = 1 << 2,
+    BIT_RIGHT       = 1 << 3,
+    BIT_JUMP        = 1 << 4,
+    BIT_SPRINT      = 1 << 5,
+    BIT_CROUCH      = 1 << 6,
+    BIT_GOD_MODE    = 1 << 7,
+    BIT_FIRE        = 1 << 8,
+    BIT_FIRE_MODE   = 1 << 9,
+    BIT_PAUSE       = 1 << 10,
+    BIT_LOOK        = 1 << 14,  // Followed by two floats
+    BIT_REPEAT      = 1 << 15   // Followed by a uint16 count of extra identical ticks
+};
+
+uint16_t packButtons(const TickInput& in) {
+    uint16_t bits = 0;
+    if (in.player.forward) bits |= BIT_FORWARD;
+    if (in.player.back)    bits |= BIT_BACK;
+    if (in.player.left)    bits |= BIT_LEFT;
+    if (in.player.right)   bits |= BIT_RIGHT;
+    if (in.player.jump)    bits |= BIT_JUMP;
+    if (in.player.sprint)  bits |= BIT_SPRINT;
+    if (in.player.crouch)  bits |= BIT_CROUCH;
+    if (in.player.godMode) bits |= BIT_GOD_MODE;
+    if (in.fire)           bits |= BIT_FIRE;
+    if (in.toggleFireMode) bits |= BIT_FIRE_MODE;
+    if (in.pause)          bits |= BIT_PAUSE;
+    if (in.look != glm::vec2(0.0f)) bits |= BIT_LOOK;
+    return bits;
+}
+
+TickInput unpackButtons(uint16_t bits) {
+    TickInput in;
+    in.player.forward = (bits & BIT_FORWARD) != 0;
+    in.player.back    = (bits & BIT_BACK) != 0;
+    in.player.left    = (bits & BIT_LEFT) != 0;
+    in.player.right   = (bits & BIT_RIGHT) != 0;
+    in.player.jump    = (bits & BIT_JUMP) != 0;
+    in.player.sprint  = (bits & BIT_SPRINT) != 0;
+    in.player.crouch  = (bits & BIT_CROUCH) != 0;
+    in.player.godMode = (bits & BIT_GOD_MODE) != 0;
+    in.fire           = (bits & BIT_FIRE) != 0;
+    in.toggleFireMode = (bits & BIT_FIRE_MODE) != 0;
+    in.pause          = (bits & BIT_PAUSE) != 0;
+    return in;
+}
+
+template <typename T>
+void put(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool get(const std::vector<char>& in, size_t& pos, T& value) {
+    if (pos + sizeof(T) > in.size()) return false;
+    std::memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+void InputRecording::clear() {
+    mapPath.clear();
+    seed = 0;
+    tickRate = 60.0f;
+    godMode = false;
+    ticks.clear();
+}
+
+bool InputRecording::save(const std::string& path) const {
+    std::vector<char> data;
+    data.insert(data.end(), MAGIC, MAGIC + 4);
+    put(data, VERSION);
+    put(data, seed);
+    put(data, tickRate);
+    put(data, static_cast<uint8_t>(godMode ? 1 : 0));
+    put(data, static_cast<uint16_t>(mapPath.size()));
+    data.insert(data.end(), mapPath.begin(), mapPath.end());
+    put(data, static_cast<uint32_t>(ticks.size()));
+
+    for (size_t i = 0; i < ticks.size();) {
+        uint16_t bits = packButtons(ticks[i]);
+
+        // Merge following ticks with the same buttons and no mouse movement
+        uint16_t repeat = 0;
+        if (!(bits & BIT_LOOK)) {
+            while (i + 1 + repeat < ticks.size() && repeat < UINT16_MAX &&
+                   packButtons(ticks[i + 1 + repeat]) == bits) {
+                ++repeat;
+            }
+        }
+        if (repeat > 0) bits |= BIT_REPEAT;
+
+        put(data, bits);
+        if (bits & BIT_LOOK) {
+            put(data, ticks[i].look.x);
+            put(data, ticks[i].look.y);
+        }
+        if (bits & BIT_REPEAT) put(data, repeat);
+        i += 1 + repeat;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        SILIC2_LOG_ERROR("Could not create input recording: " << path);
+        return false;
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+bool InputRecording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        SILIC2_LOG_ERROR("Could not open input recording: " << path);
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    clear();
+    size_t pos = 4;
+    uint32_t version = 0;
+    uint8_t god = 0;
+    uint16_t pathLength = 0;
+    uint32_t tickCount = 0;
+    if (data.size() < 4 || std::memcmp(data.data(), MAGIC, 4) != 0 ||
+        !get(data, pos, version) || version != VERSION) {
+        SILIC2_LOG_ERROR("Not a supported input recording: " << path);
+        return false;
+    }
+    if (!get(data, pos, seed) || !get(data, pos, tickRate) || !get(data, pos, god) ||
+        !get(data, pos, pathLength) || pos + pathLength > data.size()) {
+        SILIC2_LOG_ERROR("Truncated input recording header: " << path);
+        return false;
+    }
+    godMode = god != 0;
+    mapPath.assign(data.data() + pos, pathLength);
+    pos += pathLength;
+    if (!get(data, pos, tickCount)) {
+        SILIC2_LOG_ERROR("Truncated input recording header: " << path);
+        return false;
+    }
+
+    // The count comes from the file: every tick takes at least two bytes, so a corrupt
+    // header can't make us reserve more than the rest of the file could hold
+    ticks.reserve(std::min<size_t>(tickCount, (data.size() - pos) / sizeof(uint16_t)));
+    while (ticks.size() < tickCount) {
+        uint16_t bits = 0;
+        if (!get(data, pos, bits)) break;
+        TickInput in = unpackButtons(bits);
+        if ((bits & BIT_LOOK) && (!get(data, pos, in.look.x) || !get(data, pos, in.look.y))) break;
+        uint16_t repeat = 0;
+        if ((bits & BIT_REPEAT) && !get(data, pos, repeat)) break;
+        if (ticks.size() + 1 + repeat > tickCount) break;
+        ticks.insert(ticks.end(), 1 + repeat, in);
+    }
+    if (ticks.size() != tickCount) {
+        SILIC2_LOG_ERROR("Input recording " << path << " is truncated or corrupt: read " << ticks.size()
+                  << " of " << tickCount << " ticks");
+        return false;
+    }
+    return true;
+}
+
+} // namespace silic2
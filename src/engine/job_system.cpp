@@ -0,0 +1,218 @@
+#include "engine/job_system.h"
+#include <algorithm>
+#include <cstring>
+
+namespace silic2 {
+
+namespace {
+// Queue owned by the current thread: 0 outside the pool, i + 1 on worker i
+thread_local size_t threadQueue = 0;
+} // namespace
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem() {
+    queues.push_back(std::make_unique<WorkQueue>());
+}
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void JobSystem::start(unsigned workerCount) {
+    stop();
+
+    queues.resize(1);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    running = true;
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, static_cast<size_t>(i) + 1);
+    }
+}
+
+void JobSystem::stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.resize(1);
+}
+
+size_t JobSystem::currentQueue() const {
+    return threadQueue < queues.size() ? threadQueue : 0;
+}
+
+void JobSystem::submit(JobFn fn, const void* args, size_t argsSize, JobCounter& counter) {
+    WorkQueue& queue = *queues[currentQueue()];
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count < QUEUE_CAPACITY) {
+            Job& job = queue.slots[(queue.head + queue.count) & (QUEUE_CAPACITY - 1)];
+            job.fn = fn;
+            job.counter = &counter;
+            std::memcpy(job.args, args, argsSize);
+            ++queue.count;
+            counter.pending.fetch_add(1, std::memory_order_relaxed);
+            queued = true;
+        }
+    }
+    if (!queued) {
+        // Full: the caller does the work itself rather than growing the ring
+        fn(args);
+        return;
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+
+    if (!workers.empty()) {
+        // Taking the sleep lock orders this push before a worker's next predicate check
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+}
+
+bool JobSystem::popJob(size_t queue, Job& job) {
+    // Own work first, newest first (still hot in cache)
+    {
+        WorkQueue& own = *queues[queue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.count > 0) {
+            --own.count;
+            job = own.slots[(own.head + own.count) & (QUEUE_CAPACITY - 1)];
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Otherwise steal the oldest job of another queue
+    for (size_t i = 1; i < queues.size(); ++i) {
+        WorkQueue& victim = *queues[(queue + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.count > 0) {
+            job = victim.slots[victim.head];
+            victim.head = (victim.head + 1) & (QUEUE_CAPACITY - 1);
+            --victim.count;
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::runOneJob(size_t queue) {
+    Job job;
+    if (!popJob(queue, job)) return false;
+    job.fn(job.args);
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    size_t queue = currentQueue();
+    while (!counter.done()) {
+        if (!runOneJob(queue)) {
+            // Remaining jobs are running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, RangeFn fn, const void* context) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || count <= grain) {
+        fn(context, 0, count);
+        return;
+    }
+
+    size_t maxChunks = (workers.size() + 1) * CHUNKS_PER_THREAD;
+    size_t chunks = std::min((count + grain - 1) / grain, maxChunks);
+
+    // Jobs capture only this and their start, which fits a job slot
+    struct Range {
+        RangeFn fn;
+        const void* context;
+        size_t count;
+        size_t chunkSize;
+    } range = {fn, context, count, (count + chunks - 1) / chunks};
+
+    JobCounter counter;
+    for (size_t begin = range.chunkSize; begin < count; begin += range.chunkSize) {
+        const Range* r = &range;
+        submit([r, begin]() { r->fn(r->context, begin, std::min(r->count, begin + r->chunkSize)); }, counter);
+    }
+    fn(context, 0, std::min(count, range.chunkSize));
+    wait(counter);
+}
+
+void JobSystem::workerLoop(size_t queue) {
+    threadQueue = queue;
+    while (true) {
+        if (runOneJob(queue)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return queuedJobs.load(std::memory_order_acquire) > 0 || !running; });
+        if (!running && queuedJobs.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> fn, std::initializer_list<TaskId> dependencies) {
+    TaskId id = tasks.size();
+    tasks.push_back({std::move(fn), {}, static_cast<int>(dependencies.size())});
+    for (TaskId dependency : dependencies) {
+        tasks[dependency].dependents.push_back(id);
+    }
+    return id;
+}
+
+void TaskGraph::run(JobSystem& jobs) {
+    if (tasks.empty()) return;
+
+    if (remainingSize < tasks.size()) {
+        remaining.reset(new std::atomic<int>[tasks.size()]);
+        remainingSize = tasks.size();
+    }
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        remaining[i].store(tasks[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    JobCounter counter;
+    runJobs = &jobs;
+    runCounter = &counter;
+    for (TaskId id = 0; id < tasks.size(); ++id) {
+        if (tasks[id].dependencyCount == 0) launch(id);
+    }
+    jobs.wait(counter);
+    runJobs = nullptr;
+    runCounter = nullptr;
+}
+
+void TaskGraph::launch(TaskId id) {
+    // A finished task launches each dependent whose last dependency it was
+    runJobs->submit([this, id]() {
+        tasks[id].fn();
+        for (TaskId dependent : tasks[id].dependents) {
+            if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                launch(dependent);
+            }
+        }
+    }, *runCounter);
+}
+
+} // namespace silic2
@@ -0,0 +1,31 @@
+#include "engine/light_uniforms.h"
+#include "engine/shader.h"
+#include <algorithm>
+#include <string>
+
+namespace silic2 {
+
+std::vector<LightUniforms> findLightUniforms(const Shader& shader) {
+    std::vector<LightUniforms> uniforms(MAX_LIGHTS);
+    for (int i = 0; i < MAX_LIGHTS; ++i) {
+        std::string base = "lights[" + std::to_string(i) + "]";
+        uniforms[i].position  = glGetUniformLocation(shader.ID, (base + ".position").c_str());
+        uniforms[i].color     = glGetUniformLocation(shader.ID, (base + ".color").c_str());
+        uniforms[i].intensity = glGetUniformLocation(shader.ID, (base + ".intensity").c_str());
+        uniforms[i].range     = glGetUniformLocation(shader.ID, (base + ".range").c_str());
+    }
+    return uniforms;
+}
+
+int uploadLights(const std::vector<LightUniforms>& uniforms, const std::vector<LightData>& lights) {
+    int count = static_cast<int>(std::min(lights.size(), uniforms.size()));
+    for (int i = 0; i < count; ++i) {
+        glUniform3fv(uniforms[i].position, 1, &lights[i].position[0]);
+        glUniform3fv(uniforms[i].color, 1, &lights[i].color[0]);
+        glUniform1f(uniforms[i].intensity, lights[i].intensity);
+        glUniform1f(uniforms[i].range, lights[i].range);
+    }
+    return count;
+}
+
+} // namespace silic2
@@ -0,0 +1,215 @@
+#include "engine/log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace silic2 {
+
+namespace {
+const auto LOG_START = std::chrono::steady_clock::now();
+
+const char* levelTag(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "[debug] ";
+        case LogLevel::WARN:  return "[warn] ";
+        case LogLevel::ERROR: return "[error] ";
+        default:              return "";
+    }
+}
+} // namespace
+
+bool LogSite::allow() {
+    // Approximate under contention, which is fine for a console budget
+    uint32_t now = Logger::secondsNow();
+    uint32_t current = second.load(std::memory_order_relaxed);
+    if (current != now && second.compare_exchange_strong(current, now, std::memory_order_relaxed)) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    if (count.fetch_add(1, std::memory_order_relaxed) < MESSAGES_PER_SECOND) return true;
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() {
+    for (size_t i = 0; i < QUEUE_SIZE; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    stopping.store(true, std::memory_order_release);
+    wake.notify_one();
+    if (writer.joinable()) writer.join();
+}
+
+uint32_t Logger::secondsNow() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - LOG_START).count());
+}
+
+bool Logger::parseLevel(const std::string& name, LogLevel& level) {
+    if (name == "debug")      level = LogLevel::DEBUG;
+    else if (name == "info")  level = LogLevel::INFO;
+    else if (name == "warn")  level = LogLevel::WARN;
+    else if (name == "error") level = LogLevel::ERROR;
+    else if (name == "off")   level = LogLevel::OFF;
+    else return false;
+    return true;
+}
+
+void Logger::push(LogLevel level, const char* text, size_t length) {
+    // The writer is gone during static destruction; write directly instead
+    if (stopping.load(std::memory_order_acquire)) {
+        write(level, text, length);
+        std::fflush(level >= LogLevel::WARN ? stderr : stdout);
+        return;
+    }
+
+    // Bounded MPMC queue (Vyukov): claim a slot whose sequence says it is free
+    uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & (QUEUE_SIZE - 1)];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);   // Full: never block the caller
+            return;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    length = std::min(length, MESSAGE_BYTES);
+    slot->level = level;
+    slot->length = static_cast<uint16_t>(length);
+    std::memcpy(slot->text, text, length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    wake.notify_one();
+}
+
+void Logger::flush() {
+    if (stopping.load(std::memory_order_acquire)) return;
+    uint64_t target = enqueuePos.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void Logger::writerLoop() {
+    for (;;) {
+        if (writeBatch()) continue;
+        // Drained; only exit once nothing more can arrive through the queue
+        if (stopping.load(std::memory_order_acquire)) {
+            writeBatch();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+bool Logger::writeBatch() {
+    bool wroteAny = false;
+    bool wroteErr = false;
+    for (;;) {
+        Slot& slot = slots[dequeuePos & (QUEUE_SIZE - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+        write(slot.level, slot.text, slot.length);
+        wroteErr = wroteErr || slot.level >= LogLevel::WARN;
+        slot.sequence.store(dequeuePos + QUEUE_SIZE, std::memory_order_release);
+        ++dequeuePos;
+        written.store(dequeuePos, std::memory_order_release);
+        wroteAny = true;
+    }
+
+    uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != reportedDropped) {
+        std::fprintf(stderr, "[warn] %llu log message(s) dropped, queue full\n",
+                     static_cast<unsigned long long>(droppedNow - reportedDropped));
+        reportedDropped = droppedNow;
+        wroteErr = true;
+    }
+
+    // One flush per batch instead of one per line
+    if (wroteAny) std::fflush(stdout);
+    if (wroteErr) std::fflush(stderr);
+    return wroteAny;
+}
+
+void Logger::write(LogLevel level, const char* text, size_t length) {
+    std::FILE* out = level >= LogLevel::WARN ? stderr : stdout;
+    std::fputs(levelTag(level), out);
+    std::fwrite(text, 1, length, out);
+    std::fputc('\n', out);
+}
+
+LogLine::~LogLine() {
+    if (suppressed > 0) {
+        *this << " (" << suppressed << " more from here suppressed)";
+    }
+    if (truncated) {
+        std::memcpy(text + Logger::MESSAGE_BYTES - 3, "...", 3);
+    }
+    Logger::getInstance().push(level, text, length);
+}
+
+LogLine& LogLine::append(const char* data, size_t count) {
+    size_t room = Logger::MESSAGE_BYTES - length;
+    if (count > room) {
+        count = room;
+        truncated = true;
+    }
+    std::memcpy(text + length, data, count);
+    length += count;
+    return *this;
+}
+
+LogLine& LogLine::operator<<(const char* data) {
+    return data ? append(data, std::strlen(data)) : append("(null)", 6);
+}
+
+LogLine& LogLine::operator<<(const std::string& data) {
+    return append(data.data(), data.size());
+}
+
+LogLine& LogLine::operator<<(char c) {
+    return append(&c, 1);
+}
+
+LogLine& LogLine::operator<<(double value) {
+    // Same as std::ostream's default formatting
+    char buffer[32];
+    int count = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    return append(buffer, static_cast<size_t>(count));
+}
+
+LogLine& LogLine::operator<<(const void* pointer) {
+    char buffer[32];
+    int count = std::snprintf(buffer, sizeof(buffer), "%p", pointer);
+    return append(buffer, static_cast<size_t>(count));
+}
+
+LogLine& LogLine::appendSigned(long long value) {
+    char buffer[24];
+    int count = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+    return append(buffer, static_cast<size_t>(count));
+}
+
+LogLine& LogLine::appendUnsigned(unsigned long long value) {
+    char buffer[24];
+    int count = std::snprintf(buffer, sizeof(buffer), "%llu", value);
+    return append(buffer, static_cast<size_t>(count));
+}
+
+} // namespace silic2
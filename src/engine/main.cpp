@@ -1,34 +1,69 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <iostream>
+#include <string>
 #include "engine/app.h"
+#include "engine/log.h"
 
+// Usage: silic2 [map.json] [--record file | --replay file] [--log-level debug|info|warn|error|off]
 int main(int argc, char* argv[]) {
     try {
+        std::string mapArg, recordPath, replayPath;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--record" && i + 1 < argc) {
+                recordPath = argv[++i];
+            } else if (arg == "--replay" && i + 1 < argc) {
+                replayPath = argv[++i];
+            } else if (arg == "--log-level" && i + 1 < argc) {
+                silic2::LogLevel level;
+                if (silic2::Logger::parseLevel(argv[++i], level)) {
+                    silic2::Logger::getInstance().setLevel(level);
+                } else {
+                    SILIC2_LOG_WARN("Unknown log level: " << argv[i]);
+                }
+            } else {
+                mapArg = arg;
+            }
+        }
+        
         silic2::App app;
         
+        // A replay brings its own map and settings
+        if (!replayPath.empty()) {
+            if (!app.startReplay(replayPath)) {
+                SILIC2_LOG_ERROR("Failed to start replay: " << replayPath);
+                return EXIT_FAILURE;
+            }
+            app.run();
+            return EXIT_SUCCESS;
+        }
+        
         // Load map with debug output
-        std::cout << "Starting map loading process..." << std::endl;
+        SILIC2_LOG_INFO("Starting map loading process...");
         
         // Load map if specified as command line argument
-        if (argc > 1) {
-            std::string mapFile = argv[1];
-            std::cout << "Loading map from command line: " << mapFile << std::endl;
+        if (!mapArg.empty()) {
+            std::string mapFile = mapArg;
+            SILIC2_LOG_INFO("Loading map from command line: " << mapFile);
             if (!app.loadMap(mapFile)) {
-                std::cerr << "Failed to load map: " << mapFile << std::endl;
-                std::cout << "Continuing with empty scene..." << std::endl;
+                SILIC2_LOG_ERROR("Failed to load map: " << mapFile);
+                SILIC2_LOG_INFO("Continuing with empty scene...");
             }
         } else {
             // Try to load default map
-            std::cout << "Loading default map..." << std::endl;
+            SILIC2_LOG_INFO("Loading default map...");
             if (!app.loadMap("res/maps/test_room.json")) {
-                std::cout << "No default map found, starting with empty scene." << std::endl;
+                SILIC2_LOG_INFO("No default map found, starting with empty scene.");
             }
         }
         
+        if (!recordPath.empty()) {
+            app.startRecording(recordPath);
+        }
+        
         app.run();
     } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Error: " << e.what());
         return EXIT_FAILURE;
     }
     
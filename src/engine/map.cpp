@@ -1,7 +1,7 @@
 #include "engine/map.h"
+#include "engine/log.h"
 #include <fstream>
 #include <sstream>
-#include <iostream>
 #include <algorithm>
 
 namespace silic2 {
@@ -15,14 +15,14 @@ Map::~Map() {
 }
 
 bool Map::loadFromFile(const std::string& filename) {
-    std::cout << "Loading map: " << filename << std::endl;
+    SILIC2_LOG_INFO("Loading map: " << filename);
     
     std::string json_content;
     
     // Read actual file content
     std::ifstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Failed to open map file: " << filename << std::endl;
+        SILIC2_LOG_ERROR("Failed to open map file: " << filename);
         return false;
     }
     
@@ -31,41 +31,41 @@ bool Map::loadFromFile(const std::string& filename) {
     json_content = buffer.str();
     file.close();
     
-    std::cout << "Successfully read " << json_content.length() << " bytes from " << filename << std::endl;
+    SILIC2_LOG_INFO("Successfully read " << json_content.length() << " bytes from " << filename);
     
     try {
         SimpleJson json = SimpleJson::parse(json_content);
         
         if (!json.isObject()) {
-            std::cerr << "Invalid JSON format in map file" << std::endl;
+            SILIC2_LOG_ERROR("Invalid JSON format in map file");
             return false;
         }
 
         // Parse each section
         if (json.hasKey("worldSettings")) {
             if (!parseWorldSettings(json["worldSettings"])) {
-                std::cerr << "Failed to parse world settings" << std::endl;
+                SILIC2_LOG_ERROR("Failed to parse world settings");
                 return false;
             }
         }
 
         if (json.hasKey("geometry")) {
             if (!parseBrushes(json["geometry"])) {
-                std::cerr << "Failed to parse geometry" << std::endl;
+                SILIC2_LOG_ERROR("Failed to parse geometry");
                 return false;
             }
         }
 
         if (json.hasKey("entities")) {
             if (!parseEntities(json["entities"])) {
-                std::cerr << "Failed to parse entities" << std::endl;
+                SILIC2_LOG_ERROR("Failed to parse entities");
                 return false;
             }
         }
 
         if (json.hasKey("lights")) {
             if (!parseLights(json["lights"])) {
-                std::cerr << "Failed to parse lights" << std::endl;
+                SILIC2_LOG_ERROR("Failed to parse lights");
                 return false;
             }
         }
@@ -75,24 +75,25 @@ bool Map::loadFromFile(const std::string& filename) {
         
         // Analyze surface types after loading
         analyzeSurfaceTypes();
+        rebuildBrushBounds();
         
-        std::cout << "Successfully loaded map: " << filename << std::endl;
-        std::cout << "  Brushes: " << brushes.size() << std::endl;
-        std::cout << "  Entities: " << entities.size() << std::endl;
-        std::cout << "  Lights: " << lights.size() << std::endl;
+        SILIC2_LOG_INFO("Successfully loaded map: " << filename);
+        SILIC2_LOG_INFO("  Brushes: " << brushes.size());
+        SILIC2_LOG_INFO("  Entities: " << entities.size());
+        SILIC2_LOG_INFO("  Lights: " << lights.size());
         
         // Report surface type distribution
         auto floors = getFloorBrushes();
         auto ceilings = getCeilingBrushes();
         auto walls = getWallBrushes();
-        std::cout << "  Floor surfaces: " << floors.size() << std::endl;
-        std::cout << "  Ceiling surfaces: " << ceilings.size() << std::endl;
-        std::cout << "  Wall surfaces: " << walls.size() << std::endl;
+        SILIC2_LOG_INFO("  Floor surfaces: " << floors.size());
+        SILIC2_LOG_INFO("  Ceiling surfaces: " << ceilings.size());
+        SILIC2_LOG_INFO("  Wall surfaces: " << walls.size());
         
         return validate();
         
     } catch (const std::exception& e) {
-        std::cerr << "Error parsing JSON: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Error parsing JSON: " << e.what());
         return false;
     }
 }
@@ -107,14 +108,14 @@ bool Map::saveToFile(const std::string& filename) const {
 
     std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Failed to create map file: " << filename << std::endl;
+        SILIC2_LOG_ERROR("Failed to create map file: " << filename);
         return false;
     }
 
     file << json.toString();
     file.close();
     
-    std::cout << "Map saved to: " << filename << std::endl;
+    SILIC2_LOG_INFO("Map saved to: " << filename);
     return true;
 }
 
@@ -123,6 +124,11 @@ void Map::clear() {
     brushes.clear();
     entities.clear();
     lights.clear();
+    brushBounds.clear();
+    brushBVH.clear();
+    brushGrid.clear();
+    heightfield.clear();
+    occupancyGrid.clear();
     filename.clear();
     loaded = false;
 }
@@ -146,11 +152,18 @@ std::vector<Entity*> Map::getEntitiesByType(EntityType type) {
     return result;
 }
 
+void Map::addBrush(const Brush& brush) {
+    brushes.push_back(brush);
+    brushBounds.append(brush);
+    rebuildAccelerationStructures();
+}
+
 void Map::removeBrush(uint32_t id) {
     brushes.erase(
         std::remove_if(brushes.begin(), brushes.end(),
                       [id](const Brush& b) { return b.id == id; }),
         brushes.end());
+    rebuildBrushBounds();
 }
 
 void Map::removeEntity(size_t index) {
@@ -176,25 +189,25 @@ bool Map::validate() const {
     }
     
     if (!hasPlayerStart) {
-        std::cerr << "Warning: Map has no player start position" << std::endl;
+        SILIC2_LOG_WARN("Map has no player start position");
     }
     
     // Check brush validity
     for (const auto& brush : brushes) {
         if (brush.vertices.empty()) {
-            std::cerr << "Error: Brush " << brush.id << " has no vertices" << std::endl;
+            SILIC2_LOG_ERROR("Brush " << brush.id << " has no vertices");
             return false;
         }
         if (brush.faces.empty()) {
-            std::cerr << "Error: Brush " << brush.id << " has no faces" << std::endl;
+            SILIC2_LOG_ERROR("Brush " << brush.id << " has no faces");
             return false;
         }
         
         // Check face indices
         for (uint32_t face_idx : brush.faces) {
             if (face_idx >= brush.vertices.size()) {
-                std::cerr << "Error: Brush " << brush.id << " has invalid face index: " 
-                         << face_idx << std::endl;
+                SILIC2_LOG_ERROR("Brush " << brush.id << " has invalid face index: " 
+                         << face_idx);
                 return false;
             }
         }
@@ -625,6 +638,56 @@ SurfaceType Map::determineSurfaceType(const Brush& brush) {
     }
 }
 
+void Map::rebuildBrushBounds() {
+    brushBounds.clear();
+    brushBounds.reserve(brushes.size());
+    for (const auto& brush : brushes) {
+        brushBounds.append(brush);
+    }
+    rebuildAccelerationStructures();
+}
+
+void Map::rebuildAccelerationStructures() {
+    brushBVH.build(brushBounds);
+    brushGrid.build(brushBounds);
+    heightfield.build(brushBounds);
+    occupancyGrid.build(brushBounds);
+}
+
+void BrushBounds::clear() {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    flags.clear();
+}
+
+void BrushBounds::reserve(size_t count) {
+    minX.reserve(count); minY.reserve(count); minZ.reserve(count);
+    maxX.reserve(count); maxY.reserve(count); maxZ.reserve(count);
+    flags.reserve(count);
+}
+
+void BrushBounds::append(const Brush& brush) {
+    glm::vec3 bMin(0.0f), bMax(0.0f);
+    uint8_t brushFlags = 0;
+
+    if (brush.vertices.empty()) {
+        brushFlags |= EMPTY;
+    } else {
+        bMin = bMax = brush.vertices[0];
+        for (const auto& v : brush.vertices) {
+            bMin = glm::min(bMin, v);
+            bMax = glm::max(bMax, v);
+        }
+        if ((bMax.y - bMin.y) < FLAT_THICKNESS) {
+            brushFlags |= FLAT_HORIZONTAL;
+        }
+    }
+
+    minX.push_back(bMin.x); minY.push_back(bMin.y); minZ.push_back(bMin.z);
+    maxX.push_back(bMax.x); maxY.push_back(bMax.y); maxZ.push_back(bMax.z);
+    flags.push_back(brushFlags);
+}
+
 glm::vec3 Map::calculateFaceNormal(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
     glm::vec3 edge1 = v1 - v0;
     glm::vec3 edge2 = v2 - v0;
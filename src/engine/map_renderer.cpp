@@ -1,18 +1,19 @@
 #include "engine/map_renderer.h"
 #include "engine/shader.h"
+#include "engine/profiler.h"
+#include "engine/log.h"
 #include <glm/gtc/matrix_transform.hpp>
-#include <iostream>
 
 namespace silic2 {
 
 MapRenderer::MapRenderer() {
-    std::cout << "MapRenderer: Initializing..." << std::endl;
+    SILIC2_LOG_INFO("MapRenderer: Initializing...");
     wireframeMode = false;  // Disable wireframe mode for solid rendering
     try {
         initShaders();
-        std::cout << "MapRenderer created successfully with shaders" << std::endl;
+        SILIC2_LOG_INFO("MapRenderer created successfully with shaders");
     } catch (const std::exception& e) {
-        std::cerr << "Failed to initialize MapRenderer: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Failed to initialize MapRenderer: " << e.what());
         throw;
     }
 }
@@ -26,7 +27,7 @@ bool MapRenderer::loadMap(const Map& map) {
     currentMap = &map;
     
     const auto& brushes = map.getBrushes();
-    std::cout << "Loading " << brushes.size() << " brushes for rendering..." << std::endl;
+    SILIC2_LOG_INFO("Loading " << brushes.size() << " brushes for rendering...");
     
     for (const auto& brush : brushes) {
         auto renderable = std::make_unique<RenderableBrush>();
@@ -44,7 +45,7 @@ bool MapRenderer::loadMap(const Map& map) {
     
     updateLighting();
     
-    std::cout << "Map loaded successfully. " << renderableBrushes.size() << " brushes ready for rendering." << std::endl;
+    SILIC2_LOG_INFO("Map loaded successfully. " << renderableBrushes.size() << " brushes ready for rendering.");
     return true;
 }
 
@@ -56,13 +57,14 @@ void MapRenderer::clearMap() {
 }
 
 void MapRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
+    SILIC2_PROFILE_ZONE("MapRenderer::render");
     if (!currentMap) {
-        std::cout << "No current map to render" << std::endl;
+        SILIC2_LOG_DEBUG("No current map to render");
         return;
     }
     
     if (renderableBrushes.empty()) {
-        std::cout << "No renderable brushes to draw" << std::endl;
+        SILIC2_LOG_DEBUG("No renderable brushes to draw");
         return;
     }
     
@@ -90,15 +92,7 @@ void MapRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
 
     // Set lighting data
     if (lightingEnabled && !combinedLights.empty()) {
-        mapShader->setInt("numLights", std::min(static_cast<int>(combinedLights.size()), 128));
-
-        for (size_t i = 0; i < std::min(combinedLights.size(), size_t(128)); ++i) {
-            std::string base = "lights[" + std::to_string(i) + "]";
-            mapShader->setVec3(base + ".position", combinedLights[i].position);
-            mapShader->setVec3(base + ".color", combinedLights[i].color);
-            mapShader->setFloat(base + ".intensity", combinedLights[i].intensity);
-            mapShader->setFloat(base + ".range", combinedLights[i].range);
-        }
+        mapShader->setInt("numLights", uploadLights(mapLightUniforms, combinedLights));
     } else {
         mapShader->setInt("numLights", 0);
     }
@@ -115,29 +109,30 @@ void MapRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
 }
 
 void MapRenderer::initShaders() {
-    std::cout << "Initializing map shaders..." << std::endl;
+    SILIC2_LOG_INFO("Initializing map shaders...");
     try {
-        std::cout << "Loading map vertex and fragment shaders..." << std::endl;
+        SILIC2_LOG_INFO("Loading map vertex and fragment shaders...");
         mapShader = std::make_unique<Shader>("res/shaders/map.vert", "res/shaders/map.frag");
-        std::cout << "Map shaders loaded successfully" << std::endl;
+        SILIC2_LOG_INFO("Map shaders loaded successfully");
     } catch (const std::exception& e) {
-        std::cerr << "Failed to load map shaders: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Failed to load map shaders: " << e.what());
         
         // Fallback to scene shader if map shader doesn't exist
         try {
-            std::cout << "Trying fallback scene shaders..." << std::endl;
+            SILIC2_LOG_INFO("Trying fallback scene shaders...");
             mapShader = std::make_unique<Shader>("res/shaders/scene.vert", "res/shaders/scene.frag");
-            std::cout << "Using fallback scene shaders for map rendering" << std::endl;
+            SILIC2_LOG_INFO("Using fallback scene shaders for map rendering");
         } catch (const std::exception& e2) {
-            std::cerr << "Failed to load fallback shaders: " << e2.what() << std::endl;
+            SILIC2_LOG_ERROR("Failed to load fallback shaders: " << e2.what());
             throw;
         }
     }
+    mapLightUniforms = findLightUniforms(*mapShader);
 }
 
 void MapRenderer::setupBrushGeometry(const Brush& brush, RenderableBrush& renderable) {
     if (brush.vertices.empty() || brush.faces.empty()) {
-        std::cerr << "Warning: Brush " << brush.id << " has no geometry data" << std::endl;
+        SILIC2_LOG_WARN("Brush " << brush.id << " has no geometry data");
         return;
     }
     
@@ -199,8 +194,8 @@ void MapRenderer::setupBrushGeometry(const Brush& brush, RenderableBrush& render
     
     renderable.indexCount = brush.faces.size();
     
-    std::cout << "Brush " << brush.id << " setup: " << brush.vertices.size() 
-              << " vertices, " << brush.faces.size() << " indices" << std::endl;
+    SILIC2_LOG_DEBUG("Brush " << brush.id << " setup: " << brush.vertices.size() 
+              << " vertices, " << brush.faces.size() << " indices");
 }
 
 void MapRenderer::updateLighting() {
@@ -218,17 +213,17 @@ void MapRenderer::updateLighting() {
         lightData.push_back(data);
     }
     
-    std::cout << "Updated lighting: " << lightData.size() << " lights" << std::endl;
+    SILIC2_LOG_INFO("Updated lighting: " << lightData.size() << " lights");
 }
 
 void MapRenderer::renderBrush(const RenderableBrush& brush, const glm::mat4& model) {
     if (brush.VAO == 0) {
-        std::cout << "Brush has invalid VAO (0)" << std::endl;
+        SILIC2_LOG_WARN("Brush has invalid VAO (0)");
         return;
     }
     
     if (brush.indexCount == 0) {
-        std::cout << "Brush has no indices to draw" << std::endl;
+        SILIC2_LOG_WARN("Brush has no indices to draw");
         return;
     }
     
@@ -251,7 +246,7 @@ void MapRenderer::renderBrush(const RenderableBrush& brush, const glm::mat4& mod
     // Check for OpenGL errors
     GLenum error = glGetError();
     if (error != GL_NO_ERROR) {
-        std::cout << "OpenGL error after drawing brush: " << error << std::endl;
+        SILIC2_LOG_ERROR("OpenGL error after drawing brush: " << error);
     }
 }
 
@@ -0,0 +1,71 @@
+#include "engine/occupancy_grid.h"
+#include "engine/map.h"
+#include <algorithm>
+#include <cmath>
+
+namespace silic2 {
+
+void OccupancyGrid::clear() {
+    cellsX = cellsY = cellsZ = 0;
+    solidCells = 0;
+    bits.clear();
+}
+
+void OccupancyGrid::build(const BrushBounds& bounds, float requestedCellSize) {
+    clear();
+
+    bool any = false;
+    glm::vec3 worldMin(0.0f), worldMax(0.0f);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        glm::vec3 bMin(bounds.minX[i], bounds.minY[i], bounds.minZ[i]);
+        glm::vec3 bMax(bounds.maxX[i], bounds.maxY[i], bounds.maxZ[i]);
+        if (!any) {
+            worldMin = bMin;
+            worldMax = bMax;
+            any = true;
+        } else {
+            worldMin = glm::min(worldMin, bMin);
+            worldMax = glm::max(worldMax, bMax);
+        }
+    }
+    if (!any) return;
+
+    // Grow cells on very large maps so the grid stays bounded
+    glm::vec3 extent = worldMax - worldMin;
+    cellSize = requestedCellSize;
+    auto cellsFor = [&](float length) { return static_cast<int>(std::floor(length / cellSize)) + 2; };
+    while (static_cast<size_t>(cellsFor(extent.x)) * cellsFor(extent.y) * cellsFor(extent.z) > MAX_CELLS) {
+        cellSize *= 1.25f;
+    }
+    invCellSize = 1.0f / cellSize;
+    origin = worldMin - glm::vec3(0.5f * cellSize);
+    cellsX = cellsFor(extent.x);
+    cellsY = cellsFor(extent.y);
+    cellsZ = cellsFor(extent.z);
+
+    size_t cellCount = static_cast<size_t>(cellsX) * cellsY * cellsZ;
+    bits.assign((cellCount + 63) / 64, 0);
+
+    auto cellOf = [&](float value, float start, int cells) {
+        return std::clamp(static_cast<int>(std::floor((value - start) * invCellSize)), 0, cells - 1);
+    };
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (bounds.isEmpty(i)) continue;
+        int x0 = cellOf(bounds.minX[i], origin.x, cellsX), x1 = cellOf(bounds.maxX[i], origin.x, cellsX);
+        int y0 = cellOf(bounds.minY[i], origin.y, cellsY), y1 = cellOf(bounds.maxY[i], origin.y, cellsY);
+        int z0 = cellOf(bounds.minZ[i], origin.z, cellsZ), z1 = cellOf(bounds.maxZ[i], origin.z, cellsZ);
+        for (int y = y0; y <= y1; ++y)
+            for (int z = z0; z <= z1; ++z)
+                for (int x = x0; x <= x1; ++x) {
+                    size_t cell = (static_cast<size_t>(y) * cellsZ + z) * cellsX + x;
+                    bits[cell >> 6] |= uint64_t(1) << (cell & 63);
+                }
+    }
+
+    for (uint64_t word : bits) {
+        solidCells += static_cast<size_t>(__builtin_popcountll(word));
+    }
+}
+
+} // namespace silic2
@@ -1,6 +1,7 @@
 #include "engine/pixel_renderer.h"
 #include "engine/shader.h"
-#include <iostream>
+#include "engine/profiler.h"
+#include "engine/log.h"
 
 namespace silic2 {
 
@@ -29,7 +30,7 @@ bool PixelRenderer::init(int pixelWidth, int pixelHeight) {
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Failed to initialize PixelRenderer: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Failed to initialize PixelRenderer: " << e.what());
         return false;
     }
 }
@@ -100,6 +101,7 @@ void PixelRenderer::beginPixelRender() {
 }
 
 void PixelRenderer::endPixelRender(int screenWidth, int screenHeight) {
+    SILIC2_PROFILE_ZONE("PixelRenderer::endPixelRender");
     // Bind default framebuffer
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glViewport(0, 0, screenWidth, screenHeight);
@@ -0,0 +1,148 @@
+#include "engine/profiler.h"
+
+#if SILIC2_PROFILE
+
+#include "engine/log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace silic2 {
+
+namespace {
+const auto profilerEpoch = std::chrono::steady_clock::now();
+
+// This thread's ring, registered on its first zone
+thread_local void* currentRing = nullptr;
+} // namespace
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - profilerEpoch).count());
+}
+
+Profiler::ThreadRing& Profiler::threadRing() {
+    if (!currentRing) {
+        auto ring = std::make_unique<ThreadRing>();
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        ring->threadIndex = static_cast<uint32_t>(rings.size());
+        currentRing = ring.get();
+        rings.push_back(std::move(ring));
+    }
+    return *static_cast<ThreadRing*>(currentRing);
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadRing& ring = threadRing();
+    uint64_t index = ring.written.load(std::memory_order_relaxed);
+    ring.events[index % RING_SIZE] = {name, startNs, endNs};
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+size_t Profiler::zoneIndex(const char* name) {
+    // Same literal in different translation units may have different addresses
+    for (size_t i = 0; i < summary.zoneNames.size(); ++i) {
+        if (summary.zoneNames[i] == name || std::strcmp(summary.zoneNames[i], name) == 0) return i;
+    }
+    summary.zoneNames.push_back(name);
+    summary.zoneMs.push_back(0.0f);
+    return summary.zoneNames.size() - 1;
+}
+
+void Profiler::endFrame() {
+    uint64_t frameNs = now();
+    AllocationStats allocations = getAllocationStats();
+    summary.frameAllocations = allocations.count - lastAllocations.count;
+    summary.frameAllocatedBytes = allocations.bytes - lastAllocations.bytes;
+    lastAllocations = allocations;
+
+    mainThreadIndex = threadRing().threadIndex;
+    frameZoneMs.assign(summary.zoneNames.size(), 0.0f);
+
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (auto& ring : rings) {
+            uint64_t written = ring->written.load(std::memory_order_acquire);
+            uint64_t begin = ring->read;
+            if (written - begin > RING_SIZE) {
+                // The owner lapped us; the oldest zones are gone
+                droppedEvents += written - begin - RING_SIZE;
+                begin = written - RING_SIZE;
+            }
+            for (uint64_t i = begin; i < written; ++i) {
+                const ProfileEvent& event = ring->events[i % RING_SIZE];
+                size_t zone = zoneIndex(event.name);
+                if (zone >= frameZoneMs.size()) frameZoneMs.resize(zone + 1, 0.0f);
+                frameZoneMs[zone] += static_cast<float>(event.endNs - event.startNs) * 1e-6f;
+                if (captureFramesLeft > 0) captured.push_back({event, ring->threadIndex});
+            }
+            ring->read = written;
+        }
+    }
+
+    for (size_t i = 0; i < summary.zoneMs.size(); ++i) {
+        summary.zoneMs[i] += (frameZoneMs[i] - summary.zoneMs[i]) * SMOOTHING;
+    }
+    if (lastFrameNs != 0) {
+        summary.frameMs[summary.frameCursor] = static_cast<float>(frameNs - lastFrameNs) * 1e-6f;
+        summary.frameCursor = (summary.frameCursor + 1) % ProfileSummary::HISTORY_FRAMES;
+    }
+    lastFrameNs = frameNs;
+
+    if (captureFramesLeft > 0 && --captureFramesLeft == 0) {
+        if (writeChromeTrace(capturePath)) {
+            SILIC2_LOG_INFO("Wrote " << captured.size() << " profiler zones to " << capturePath);
+        }
+        captured.clear();
+    }
+}
+
+void Profiler::captureFrames(size_t frames, const std::string& path) {
+    captured.clear();
+    capturePath = path;
+    captureFramesLeft = frames;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        SILIC2_LOG_ERROR("Failed to open " << path << " for writing");
+        return false;
+    }
+
+    // Complete ("X") events in microseconds, one track per recording thread
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    const char* separator = "";
+    uint32_t threadCount = 0;
+    for (const CapturedEvent& c : captured) {
+        file << separator << "{\"name\":\"" << c.event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << c.threadIndex
+             << ",\"ts\":" << static_cast<double>(c.event.startNs) * 1e-3
+             << ",\"dur\":" << static_cast<double>(c.event.endNs - c.event.startNs) * 1e-3 << "}";
+        separator = ",\n";
+        threadCount = std::max(threadCount, c.threadIndex + 1);
+    }
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        file << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t
+             << ",\"args\":{\"name\":\"" << (t == mainThreadIndex ? "main" : "worker") << " " << t << "\"}}";
+        separator = ",\n";
+    }
+    file << "\n]}\n";
+
+    if (!file) {
+        SILIC2_LOG_ERROR("Failed to write " << path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace silic2
+
+#endif
@@ -1,7 +1,7 @@
 #include "engine/shader.h"
+#include "engine/log.h"
 #include <fstream>
 #include <sstream>
-#include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 
 namespace silic2 {
@@ -35,12 +35,12 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         vertexCode = vShaderStream.str();
         fragmentCode = fShaderStream.str();
         
-        std::cout << "Successfully loaded shaders: " << vertexPath << ", " << fragmentPath << std::endl;
+        SILIC2_LOG_INFO("Successfully loaded shaders: " << vertexPath << ", " << fragmentPath);
     }
     catch (std::ifstream::failure& e) {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
-        std::cout << "Vertex path: " << vertexPath << std::endl;
-        std::cout << "Fragment path: " << fragmentPath << std::endl;
+        SILIC2_LOG_ERROR("ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what());
+        SILIC2_LOG_ERROR("Vertex path: " << vertexPath);
+        SILIC2_LOG_ERROR("Fragment path: " << fragmentPath);
         throw;
     }
     
@@ -74,6 +74,43 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     glDeleteShader(fragment);
 }
 
+Shader::Shader(const char* vertexPath, const std::vector<const char*>& feedbackVaryings) {
+    std::string vertexCode;
+    std::ifstream vShaderFile;
+    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    
+    try {
+        vShaderFile.open(vertexPath);
+        std::stringstream vShaderStream;
+        vShaderStream << vShaderFile.rdbuf();
+        vShaderFile.close();
+        vertexCode = vShaderStream.str();
+        
+        SILIC2_LOG_INFO("Successfully loaded shader: " << vertexPath);
+    }
+    catch (std::ifstream::failure& e) {
+        SILIC2_LOG_ERROR("ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what());
+        SILIC2_LOG_ERROR("Vertex path: " << vertexPath);
+        throw;
+    }
+    
+    const char* vShaderCode = vertexCode.c_str();
+    unsigned int vertex = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex, 1, &vShaderCode, NULL);
+    glCompileShader(vertex);
+    checkCompileErrors(vertex, "VERTEX");
+    
+    // Varyings must be declared before linking
+    ID = glCreateProgram();
+    glAttachShader(ID, vertex);
+    glTransformFeedbackVaryings(ID, static_cast<GLsizei>(feedbackVaryings.size()),
+                                feedbackVaryings.data(), GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(ID);
+    checkCompileErrors(ID, "PROGRAM");
+    
+    glDeleteShader(vertex);
+}
+
 Shader::~Shader() {
     glDeleteProgram(ID);
 }
@@ -138,14 +175,14 @@ void Shader::checkCompileErrors(unsigned int shader, std::string type) {
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
         if (!success) {
             glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-            std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n";
+            SILIC2_LOG_ERROR("ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog);
         }
     }
     else {
         glGetProgramiv(shader, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-            std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n";
+            SILIC2_LOG_ERROR("ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog);
         }
     }
 }
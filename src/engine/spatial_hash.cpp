@@ -0,0 +1,175 @@
+#include "engine/spatial_hash.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace silic2 {
+
+SpatialHash::SpatialHash(float cellSize)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize) {
+}
+
+void SpatialHash::clear() {
+    items.clear();
+    cells.clear();
+    activeCount = 0;
+}
+
+int SpatialHash::cellCoord(float v) const {
+    return static_cast<int>(std::floor(v * invCellSize));
+}
+
+uint64_t SpatialHash::cellKey(int x, int z) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+void SpatialHash::addToCells(uint32_t id, const Item& item) {
+    for (int z = item.z0; z <= item.z1; ++z) {
+        for (int x = item.x0; x <= item.x1; ++x) {
+            cells[cellKey(x, z)].push_back(id);
+        }
+    }
+}
+
+void SpatialHash::removeFromCells(uint32_t id, const Item& item) {
+    for (int z = item.z0; z <= item.z1; ++z) {
+        for (int x = item.x0; x <= item.x1; ++x) {
+            auto it = cells.find(cellKey(x, z));
+            if (it == cells.end()) continue;
+            // Cell lists are short and unordered: swap-and-pop.
+            // Empty cells are kept so their storage is reused.
+            std::vector<uint32_t>& list = it->second;
+            auto pos = std::find(list.begin(), list.end(), id);
+            if (pos != list.end()) {
+                *pos = list.back();
+                list.pop_back();
+            }
+        }
+    }
+}
+
+void SpatialHash::insert(uint32_t id, const AABB& box) {
+    if (id >= items.size()) items.resize(id + 1);
+    Item& item = items[id];
+    if (item.active) {
+        update(id, box);
+        return;
+    }
+    item.box = box;
+    item.x0 = cellCoord(box.min.x);
+    item.z0 = cellCoord(box.min.z);
+    item.x1 = cellCoord(box.max.x);
+    item.z1 = cellCoord(box.max.z);
+    item.active = true;
+    addToCells(id, item);
+    ++activeCount;
+}
+
+void SpatialHash::update(uint32_t id, const AABB& box) {
+    if (!contains(id)) {
+        insert(id, box);
+        return;
+    }
+    Item& item = items[id];
+    item.box = box;
+
+    int x0 = cellCoord(box.min.x), z0 = cellCoord(box.min.z);
+    int x1 = cellCoord(box.max.x), z1 = cellCoord(box.max.z);
+    if (x0 == item.x0 && z0 == item.z0 && x1 == item.x1 && z1 == item.z1) return;
+
+    removeFromCells(id, item);
+    item.x0 = x0; item.z0 = z0;
+    item.x1 = x1; item.z1 = z1;
+    addToCells(id, item);
+}
+
+void SpatialHash::remove(uint32_t id) {
+    if (!contains(id)) return;
+    Item& item = items[id];
+    removeFromCells(id, item);
+    item.active = false;
+    --activeCount;
+}
+
+void SpatialHash::appendCell(int x, int z, std::vector<uint32_t>& out) const {
+    auto it = cells.find(cellKey(x, z));
+    if (it != cells.end()) {
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+}
+
+void SpatialHash::sortUnique(std::vector<uint32_t>& out) {
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void SpatialHash::queryBox(const AABB& box, std::vector<uint32_t>& out) const {
+    out.clear();
+    int x0 = cellCoord(box.min.x), z0 = cellCoord(box.min.z);
+    int x1 = cellCoord(box.max.x), z1 = cellCoord(box.max.z);
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            appendCell(x, z, out);
+        }
+    }
+    out.erase(std::remove_if(out.begin(), out.end(),
+                  [&](uint32_t id) { return !items[id].box.intersects(box); }),
+              out.end());
+    sortUnique(out);
+}
+
+void SpatialHash::queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const {
+    out.clear();
+    int x0 = cellCoord(center.x - radius), z0 = cellCoord(center.z - radius);
+    int x1 = cellCoord(center.x + radius), z1 = cellCoord(center.z + radius);
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            appendCell(x, z, out);
+        }
+    }
+    float radiusSq = radius * radius;
+    out.erase(std::remove_if(out.begin(), out.end(),
+                  [&](uint32_t id) {
+                      const AABB& b = items[id].box;
+                      float dx = center.x - std::clamp(center.x, b.min.x, b.max.x);
+                      float dz = center.z - std::clamp(center.z, b.min.z, b.max.z);
+                      return dx * dx + dz * dz > radiusSq;
+                  }),
+              out.end());
+    sortUnique(out);
+}
+
+void SpatialHash::querySegment(const glm::vec3& start, const glm::vec3& end, std::vector<uint32_t>& out) const {
+    out.clear();
+
+    // 2D DDA over the XZ cells crossed by the segment
+    int x = cellCoord(start.x), z = cellCoord(start.z);
+    const int endX = cellCoord(end.x), endZ = cellCoord(end.z);
+    const float dx = end.x - start.x, dz = end.z - start.z;
+    const int stepX = dx > 0.0f ? 1 : -1;
+    const int stepZ = dz > 0.0f ? 1 : -1;
+    const float inf = std::numeric_limits<float>::infinity();
+    float tMaxX = dx != 0.0f ? ((x + (stepX > 0 ? 1 : 0)) * cellSize - start.x) / dx : inf;
+    float tMaxZ = dz != 0.0f ? ((z + (stepZ > 0 ? 1 : 0)) * cellSize - start.z) / dz : inf;
+    const float tDeltaX = dx != 0.0f ? cellSize / std::abs(dx) : inf;
+    const float tDeltaZ = dz != 0.0f ? cellSize / std::abs(dz) : inf;
+
+    int steps = std::abs(endX - x) + std::abs(endZ - z);
+    appendCell(x, z, out);
+    for (int i = 0; i < steps; ++i) {
+        // Never step past the end cell on an axis, whatever rounding says
+        bool moveX = (x != endX) && (z == endZ || tMaxX < tMaxZ);
+        if (moveX) {
+            x += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            z += stepZ;
+            tMaxZ += tDeltaZ;
+        }
+        appendCell(x, z, out);
+    }
+    sortUnique(out);
+}
+
+} // namespace silic2
@@ -0,0 +1,109 @@
+#include "engine/stream_buffer.h"
+#include "engine/log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace silic2 {
+
+// Writes go through GL_COPY_WRITE_BUFFER so they don't disturb the caller's array binding
+static constexpr GLenum STREAM_TARGET = GL_COPY_WRITE_BUFFER;
+
+StreamBuffer& StreamBuffer::getInstance() {
+    static StreamBuffer instance;
+    return instance;
+}
+
+void StreamBuffer::allocate(size_t bytesPerRegion) {
+    // Draws already issued against the old buffer keep it alive until they finish
+    shutdown();
+    regionBytes = bytesPerRegion;
+    region = 0;
+    head = 0;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(STREAM_TARGET, buffer);
+    glBufferData(STREAM_TARGET, FRAMES_IN_FLIGHT * regionBytes, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(STREAM_TARGET, 0);
+}
+
+StreamSlice StreamBuffer::map(size_t bytes, size_t alignment) {
+    StreamSlice slice;
+    if (bytes == 0) return slice;
+    if (mapped) unmap();
+
+    size_t start = (head + alignment - 1) / alignment * alignment;
+    if (buffer == 0) {
+        allocate(std::max(DEFAULT_REGION_BYTES, bytes));
+        start = 0;
+    } else if (start + bytes > regionBytes) {
+        size_t grown = std::max(regionBytes * 2, bytes);
+        SILIC2_LOG_WARN("Stream buffer region full, growing to " << grown << " bytes");
+        allocate(grown);
+        start = 0;
+    }
+
+    slice.buffer = buffer;
+    slice.offset = region * regionBytes + start;
+    glBindBuffer(STREAM_TARGET, buffer);
+    // This range belongs to the current frame only, so there is nothing to wait for
+    slice.data = glMapBufferRange(STREAM_TARGET, slice.offset, bytes,
+                                  GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (!slice.data) {
+        glBindBuffer(STREAM_TARGET, 0);
+        return StreamSlice{};
+    }
+    mapped = true;
+    head = start + bytes;
+    return slice;
+}
+
+void StreamBuffer::unmap() {
+    if (!mapped) return;
+    glBindBuffer(STREAM_TARGET, buffer);
+    glUnmapBuffer(STREAM_TARGET);
+    glBindBuffer(STREAM_TARGET, 0);
+    mapped = false;
+}
+
+StreamSlice StreamBuffer::upload(const void* data, size_t bytes, size_t alignment) {
+    StreamSlice slice = map(bytes, alignment);
+    if (slice.data) {
+        std::memcpy(slice.data, data, bytes);
+        unmap();
+    }
+    return slice;
+}
+
+void StreamBuffer::endFrame() {
+    if (buffer == 0) return;
+    unmap();
+
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    region = (region + 1) % FRAMES_IN_FLIGHT;
+    head = 0;
+
+    // The region we move into was last written FRAMES_IN_FLIGHT - 1 frames ago
+    GLsync fence = fences[region];
+    if (!fence) return;
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        ++stalledFrames;
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fences[region] = nullptr;
+}
+
+void StreamBuffer::shutdown() {
+    if (buffer == 0) return;
+    unmap();
+    for (GLsync& fence : fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+} // namespace silic2
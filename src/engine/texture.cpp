@@ -1,5 +1,5 @@
 #include "engine/texture.h"
-#include <iostream>
+#include "engine/log.h"
 
 // Need to define STB_IMAGE_IMPLEMENTATION to implement stb_image
 #define STB_IMAGE_IMPLEMENTATION
@@ -23,8 +23,8 @@ bool Texture::loadFromFile(const std::string& filePath) {
     // Load image data
     unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
     if (!data) {
-        std::cerr << "Failed to load texture: " << filePath << std::endl;
-        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
+        SILIC2_LOG_ERROR("Failed to load texture: " << filePath);
+        SILIC2_LOG_ERROR("Reason: " << stbi_failure_reason());
         return false;
     }
     
@@ -57,7 +57,7 @@ bool Texture::loadFromFile(const std::string& filePath) {
     // Free image data
     stbi_image_free(data);
     
-    std::cout << "Loaded texture: " << filePath << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
+    SILIC2_LOG_INFO("Loaded texture: " << filePath << " (" << width << "x" << height << ", " << channels << " channels)");
     
     return true;
 }
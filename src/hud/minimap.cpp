@@ -1,6 +1,7 @@
 #include "hud/minimap.h"
 #include "engine/shader.h"
 #include "engine/map.h"
+#include "engine/stream_buffer.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -31,13 +32,17 @@ Minimap::Minimap() = default;
 
 Minimap::~Minimap() {
     if (mapVAO) { glDeleteVertexArrays(1, &mapVAO); glDeleteBuffers(1, &mapVBO); }
-    if (dynVAO) { glDeleteVertexArrays(1, &dynVAO); glDeleteBuffers(1, &dynVBO); }
+    if (dynVAO) glDeleteVertexArrays(1, &dynVAO);
 }
 
 void Minimap::init() {
     shader = std::make_unique<Shader>("res/shaders/minimap.vert", "res/shaders/minimap.frag");
     makeVAO(mapVAO, mapVBO);
-    makeVAO(dynVAO, dynVBO);
+    // The dynamic geometry lives in the shared stream buffer; render() points attribute 0 at it
+    glGenVertexArrays(1, &dynVAO);
+    glBindVertexArray(dynVAO);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
 }
 
 void Minimap::setMap(const Map* map) {
@@ -78,8 +83,9 @@ void Minimap::buildMapGeometry(const Map* map) {
 
 void Minimap::render(const glm::vec3& playerPos,
                      const glm::vec3& playerFront,
-                     const std::vector<glm::vec3>& enemyPositions,
-                     int screenW, int screenH) {
+                     const FrameVector<glm::vec3>& enemyPositions,
+                     int screenW, int screenH,
+                     FrameArena& arena) {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -103,7 +109,10 @@ void Minimap::render(const glm::vec3& playerPos,
     // ------------------------------------------------------------------
     // Build dynamic vertex buffer: [background | enemies | player arrow]
     // ------------------------------------------------------------------
-    std::vector<float> dyn;
+    static constexpr int   CIRCLE_SEG  = 20;
+    static constexpr float TWO_PI      = 6.28318530718f;
+    // 12 floats of background, 6 per circle segment, 6 for the arrow
+    auto dyn = makeFrameVector<float>(arena, 12 + enemyPositions.size() * CIRCLE_SEG * 6 + 6);
 
     // mmToWorld: converts minimap normalised coords back to world XZ so the
     // vertex shader can round-trip them to the intended on-screen position.
@@ -124,9 +133,6 @@ void Minimap::render(const glm::vec3& playerPos,
     int bgEnd = static_cast<int>(dyn.size() / 2);
 
     // Enemy circles — triangle fan in mmNorm space so they stay round.
-    static constexpr int   CIRCLE_SEG  = 20;
-    static constexpr float CIRCLE_R    = 0.045f; // radius in mmNorm [0,1] space
-    static constexpr float TWO_PI      = 6.28318530718f;
     for (const auto& ep : enemyPositions) {
         // Enemy position in mmNorm space
         float relX = ep.x - px, relZ = ep.z - pz;
@@ -152,9 +158,14 @@ void Minimap::render(const glm::vec3& playerPos,
     int arrowEnd = static_cast<int>(dyn.size() / 2);
 
     // Upload
+    StreamSlice slice = StreamBuffer::getInstance().upload(dyn.data(), dyn.size() * sizeof(float));
     glBindVertexArray(dynVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, dynVBO);
-    glBufferData(GL_ARRAY_BUFFER, dyn.size() * sizeof(float), dyn.data(), GL_DYNAMIC_DRAW);
+    if (slice.data) {
+        glBindBuffer(GL_ARRAY_BUFFER, slice.buffer);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)slice.offset);
+    } else {
+        arrowEnd = enemyEnd = bgEnd = 0;   // Nothing to draw but the walls
+    }
 
     // ------------------------------------------------------------------
     // Draw passes
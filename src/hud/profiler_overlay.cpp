@@ -0,0 +1,102 @@
+#include "hud/profiler_overlay.h"
+#include <algorithm>
+
+namespace silic2 {
+
+namespace {
+struct PaletteEntry {
+    glm::vec4 color;
+    const char* name;
+};
+
+const PaletteEntry ZONE_PALETTE[] = {
+    {glm::vec4(0.90f, 0.30f, 0.25f, 0.9f), "red"},
+    {glm::vec4(0.95f, 0.65f, 0.20f, 0.9f), "orange"},
+    {glm::vec4(0.95f, 0.90f, 0.30f, 0.9f), "yellow"},
+    {glm::vec4(0.40f, 0.85f, 0.35f, 0.9f), "green"},
+    {glm::vec4(0.30f, 0.85f, 0.85f, 0.9f), "cyan"},
+    {glm::vec4(0.35f, 0.55f, 0.95f, 0.9f), "blue"},
+    {glm::vec4(0.70f, 0.45f, 0.95f, 0.9f), "purple"},
+    {glm::vec4(0.95f, 0.50f, 0.80f, 0.9f), "pink"},
+    {glm::vec4(0.85f, 0.85f, 0.85f, 0.9f), "white"},
+    {glm::vec4(0.60f, 0.45f, 0.30f, 0.9f), "brown"},
+};
+constexpr size_t PALETTE_SIZE = sizeof(ZONE_PALETTE) / sizeof(ZONE_PALETTE[0]);
+} // namespace
+
+ProfilerOverlay::ProfilerOverlay() = default;
+
+ProfilerOverlay::~ProfilerOverlay() = default;
+
+bool ProfilerOverlay::init() {
+    // Same flat screen-space quads as the health bars
+    return rects.init();
+}
+
+glm::vec4 ProfilerOverlay::zoneColor(size_t index) {
+    return ZONE_PALETTE[index % PALETTE_SIZE].color;
+}
+
+const char* ProfilerOverlay::zoneColorName(size_t index) {
+    return ZONE_PALETTE[index % PALETTE_SIZE].name;
+}
+
+void ProfilerOverlay::render(int screenW, int screenH, const ProfileSummary& summary, const GpuFrameStats* gpu) {
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    const size_t rows = summary.zoneNames.size();
+    const size_t gpuRows = (gpu && gpu->valid) ? GpuFrameStats::PASS_COUNT : 0;
+    // Panel, history columns, budget line, allocation light, zone and GPU bars
+    rects.begin(1 + ProfileSummary::HISTORY_FRAMES + 2 + rows + gpuRows);
+    const float panelH = GRAPH_HEIGHT + 6.0f + rows * (BAR_HEIGHT + 2.0f)
+                       + (gpuRows > 0 ? 6.0f + gpuRows * (BAR_HEIGHT + 2.0f) : 0.0f);
+    rects.add(MARGIN - 4.0f, MARGIN - 4.0f, WIDTH + 8.0f, panelH + 8.0f, glm::vec4(0.05f, 0.05f, 0.05f, 0.7f));
+
+    // --- Frame-time history, oldest frame on the left ---
+    const size_t frames = ProfileSummary::HISTORY_FRAMES;
+    const float columnW = WIDTH / static_cast<float>(frames);
+    const float graphBottom = MARGIN + GRAPH_HEIGHT;
+    for (size_t i = 0; i < frames; ++i) {
+        float ms = summary.frameMs[(summary.frameCursor + i) % frames];
+        if (ms <= 0.0f) continue;
+        float h = std::min(ms / (2.0f * BUDGET_MS), 1.0f) * GRAPH_HEIGHT;
+        glm::vec4 col = ms <= BUDGET_MS        ? glm::vec4(0.2f, 0.8f, 0.3f, 0.9f)
+                      : ms <= 2.0f * BUDGET_MS ? glm::vec4(0.9f, 0.8f, 0.2f, 0.9f)
+                                               : glm::vec4(0.9f, 0.2f, 0.15f, 0.9f);
+        rects.add(MARGIN + i * columnW, graphBottom - h, std::max(columnW - 0.5f, 1.0f), h, col);
+    }
+    // 60 Hz budget line halfway up the strip
+    rects.add(MARGIN, graphBottom - GRAPH_HEIGHT * 0.5f, WIDTH, 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.6f));
+
+    // Heap allocation light in the top-right corner: green when the last frame made none
+    glm::vec4 allocCol = summary.frameAllocations == 0 ? glm::vec4(0.2f, 0.8f, 0.3f, 1.0f)
+                                                       : glm::vec4(0.9f, 0.2f, 0.15f, 1.0f);
+    rects.add(MARGIN + WIDTH - 6.0f, MARGIN, 6.0f, 6.0f, allocCol);
+
+    // --- One bar per zone: smoothed ms per frame, full width = one 60 Hz frame ---
+    float y = graphBottom + 6.0f;
+    for (size_t i = 0; i < rows; ++i) {
+        float w = std::min(summary.zoneMs[i] / BUDGET_MS, 1.0f) * WIDTH;
+        if (w > 0.0f) rects.add(MARGIN, y, std::max(w, 1.0f), BAR_HEIGHT, zoneColor(i));
+        y += BAR_HEIGHT + 2.0f;
+    }
+
+    // --- GPU passes, same scale, below a gap ---
+    if (gpuRows > 0) {
+        y += 6.0f;
+        for (size_t i = 0; i < gpuRows; ++i) {
+            float w = std::min(gpu->passMs[i] / BUDGET_MS, 1.0f) * WIDTH;
+            if (w > 0.0f) rects.add(MARGIN, y, std::max(w, 1.0f), BAR_HEIGHT, zoneColor(i));
+            y += BAR_HEIGHT + 2.0f;
+        }
+    }
+
+    rects.end(screenW, screenH);
+
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+}
+
+} // namespace silic2
@@ -0,0 +1,71 @@
+#include "hud/rect_batch.h"
+#include "engine/shader.h"
+
+namespace silic2 {
+
+RectBatch::RectBatch() = default;
+
+RectBatch::~RectBatch() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+}
+
+bool RectBatch::init() {
+    shader = std::make_unique<Shader>("res/shaders/healthbar.vert", "res/shaders/healthbar.frag");
+
+    // Attributes are pointed at each batch's stream buffer slice in end()
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    return true;
+}
+
+bool RectBatch::begin(size_t maxRects) {
+    count = 0;
+    capacity = 0;
+    slice = StreamSlice{};
+    if (maxRects == 0) return false;
+    slice = StreamBuffer::getInstance().map(maxRects * VERTICES_PER_RECT * FLOATS_PER_VERTEX * sizeof(float));
+    if (!slice.data) return false;
+    capacity = maxRects;
+    return true;
+}
+
+void RectBatch::add(float x, float y, float w, float h, const glm::vec4& color) {
+    if (count >= capacity) return;
+    const float corners[VERTICES_PER_RECT][2] = {
+        {x,     y    }, {x + w, y    }, {x + w, y + h},
+        {x,     y    }, {x + w, y + h}, {x,     y + h}
+    };
+    float* out = static_cast<float*>(slice.data) + count * VERTICES_PER_RECT * FLOATS_PER_VERTEX;
+    for (const auto& corner : corners) {
+        *out++ = corner[0];
+        *out++ = corner[1];
+        *out++ = color.r;
+        *out++ = color.g;
+        *out++ = color.b;
+        *out++ = color.a;
+    }
+    ++count;
+}
+
+void RectBatch::end(int screenW, int screenH) {
+    if (!slice.data) return;
+    StreamBuffer::getInstance().unmap();
+    slice.data = nullptr;
+    if (count == 0) return;
+
+    const GLsizei stride = FLOATS_PER_VERTEX * sizeof(float);
+    shader->use();
+    shader->setVec2("screenSize", static_cast<float>(screenW), static_cast<float>(screenH));
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, slice.buffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)slice.offset);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(slice.offset + 2 * sizeof(float)));
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count * VERTICES_PER_RECT));
+    glBindVertexArray(0);
+}
+
+} // namespace silic2
@@ -0,0 +1,38 @@
+#include "player/bullet_pool.h"
+
+namespace silic2 {
+
+BulletPool::BulletPool(size_t capacity)
+    : position(capacity), prevPosition(capacity), velocity(capacity), lifetime(capacity, 0.0f) {
+}
+
+bool BulletPool::spawn(const glm::vec3& pos, const glm::vec3& vel) {
+    if (count == position.size()) return false;
+    position[count] = pos;
+    prevPosition[count] = pos;
+    velocity[count] = vel;
+    lifetime[count] = 0.0f;
+    ++count;
+    return true;
+}
+
+void BulletPool::remove(size_t index) {
+    size_t last = count - 1;
+    if (index != last) {
+        position[index] = position[last];
+        prevPosition[index] = prevPosition[last];
+        velocity[index] = velocity[last];
+        lifetime[index] = lifetime[last];
+    }
+    count = last;
+}
+
+void BulletPool::integrate(size_t begin, size_t end, float deltaTime) {
+    for (size_t i = begin; i < end; ++i) {
+        prevPosition[i] = position[i];
+        position[i] += velocity[i] * deltaTime;
+        lifetime[i] += deltaTime;
+    }
+}
+
+} // namespace silic2
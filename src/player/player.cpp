@@ -2,7 +2,7 @@
 #include "engine/camera.h"
 #include "engine/map.h"
 #include "engine/game_config.h"
-#include <GLFW/glfw3.h>
+#include "engine/profiler.h"
 #include <iostream>
 #include <algorithm>
 #include <cstdlib>
@@ -18,6 +18,7 @@ Player::Player(const glm::vec3& startPosition)
 }
 
 void Player::update(float deltaTime, const Map* map) {
+    SILIC2_PROFILE_ZONE("Player::update");
     // Update physics (skip if in god mode)
     if (!isGodMode()) {
         updatePhysics(deltaTime, map);
@@ -69,10 +70,10 @@ void Player::update(float deltaTime, const Map* map) {
     }
 }
 
-void Player::processInput(GLFWwindow* window, Camera* camera, float deltaTime) {
+void Player::processInput(const PlayerInput& input, Camera* camera, float deltaTime) {
     // God mode toggle
     wasGodModePressed = godModePressed;
-    godModePressed = glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS;
+    godModePressed = input.godMode;
     
     // Toggle god mode when G is first pressed
     if (godModePressed && !wasGodModePressed) {
@@ -81,7 +82,7 @@ void Player::processInput(GLFWwindow* window, Camera* camera, float deltaTime) {
     }
     
     // Get movement input
-    glm::vec3 movement = getMovementInput(window, camera, deltaTime);
+    glm::vec3 movement = getMovementInput(input, camera, deltaTime);
     
     if (isGodMode()) {
         // In god mode, apply movement directly to position for free flight
@@ -122,7 +123,7 @@ void Player::processInput(GLFWwindow* window, Camera* camera, float deltaTime) {
         
         // Ctrl input for crouching/sliding
         wasCrouchPressed = crouchPressed;
-        crouchPressed = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS;
+        crouchPressed = input.crouch;
         
         // Handle Ctrl press
         if (crouchPressed && !wasCrouchPressed && onGround) {
@@ -184,7 +185,7 @@ void Player::processInput(GLFWwindow* window, Camera* camera, float deltaTime) {
         
         // Sprint toggle with Shift
         wasShiftPressed = shiftPressed;
-        shiftPressed = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS;
+        shiftPressed = input.sprint;
         
         // Toggle sprint when Shift is first pressed (only if not crouching or sliding)
         if (shiftPressed && !wasShiftPressed && !crouching && !sliding) {
@@ -192,12 +193,11 @@ void Player::processInput(GLFWwindow* window, Camera* camera, float deltaTime) {
         }
         
         // Update sprinting state - only sprint if toggled and moving forward
-        bool wPressed = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
-        sprinting = sprintToggled && wPressed && !crouching && !sliding;
+        sprinting = sprintToggled && input.forward && !crouching && !sliding;
         
         // Jump input
         wasJumpPressed = jumpPressed;
-        jumpPressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+        jumpPressed = input.jump;
         
         // Jump interrupts slide or normal jump
         if (jumpPressed && !wasJumpPressed && onGround) {
@@ -372,40 +372,6 @@ void Player::updatePhysics(float deltaTime, const Map* map) {
     onGround = checkGroundCollision(map);
 }
 
-void Player::handleMapCollision(const Map* map) {
-    if (!map) return;
-    
-    AABB playerBox = getAABB();
-    const auto& brushes = map->getBrushes();
-    
-    for (const auto& brush : brushes) {
-        // Calculate brush AABB
-        if (brush.vertices.empty()) continue;
-        
-        glm::vec3 brushMin = brush.vertices[0];
-        glm::vec3 brushMax = brush.vertices[0];
-        
-        for (const auto& vertex : brush.vertices) {
-            brushMin = glm::min(brushMin, vertex);
-            brushMax = glm::max(brushMax, vertex);
-        }
-        
-        AABB brushBox(brushMin, brushMax);
-        
-        // Check collision and resolve
-        if (CollisionSystem::checkAABB(playerBox, brushBox)) {
-            glm::vec3 resolution = CollisionSystem::resolveAABBCollision(playerBox, brushBox);
-            position += resolution;
-            
-            // If pushed upward, we're standing on ground
-            if (resolution.y > 0) {
-                onGround = true;
-                velocity.y = 0.0f;
-            }
-        }
-    }
-}
-
 bool Player::checkGroundCollision(const Map* map) {
     if (!map) return false;
     
@@ -414,124 +380,125 @@ bool Player::checkGroundCollision(const Map* map) {
     const auto& config = GameConfig::getInstance().player;
     groundCheckBox.min.y -= config.groundCheckDistance;
     
-    const auto& brushes = map->getBrushes();
-    
-    for (const auto& brush : brushes) {
-        if (brush.vertices.empty()) continue;
-        
-        glm::vec3 brushMin = brush.vertices[0];
-        glm::vec3 brushMax = brush.vertices[0];
-        
-        for (const auto& vertex : brush.vertices) {
-            brushMin = glm::min(brushMin, vertex);
-            brushMax = glm::max(brushMax, vertex);
-        }
-        
-        AABB brushBox(brushMin, brushMax);
-        
-        if (CollisionSystem::checkAABB(groundCheckBox, brushBox)) {
-            // Additional check: ensure brush is below player
-            if (brushBox.max.y <= position.y + 0.1f) {
-                return true;
-            }
-        }
-    }
-    
-    return false;
+    // Only surfaces at or below the player's feet count as ground
+    float groundTop;
+    return map->getHeightfield().findGround(groundCheckBox, position.y + 0.1f, groundTop);
 }
 
 glm::vec3 Player::moveWithCollision(const glm::vec3& movement, const Map* map) {
     if (!map || isGodMode()) return movement; // Skip collision in god mode
     
-    glm::vec3 finalMovement = movement;
-    AABB originalBox = getAABB();
-    
-    const auto& brushes = map->getBrushes();
-    
     const auto& config = GameConfig::getInstance().player;
+    const auto& bounds = map->getBrushBounds();
+    const AABB startBox = getAABB();
+    
+    // Broadphase once: the full swept box, raised by the step height so step-up
+    // probes stay inside it
+    AABB sweptBox(glm::min(startBox.min, startBox.min + movement) - glm::vec3(COLLISION_SKIN),
+                  glm::max(startBox.max, startBox.max + movement) +
+                      glm::vec3(COLLISION_SKIN, config.stepHeight + COLLISION_SKIN, COLLISION_SKIN));
+    map->getBrushGrid().query(sweptBox, nearbyBrushes);
+    
+    // Earliest time of impact of 'box' moving by 'move' against the candidates
+    auto sweep = [&](const AABB& box, const glm::vec3& move, float& toi, glm::vec3& normal, uint32_t& brush) {
+        bool hit = false;
+        toi = 1.0f;
+        for (uint32_t i : nearbyBrushes) {
+            CollisionResult result = CollisionSystem::sweepAABB(box, move, bounds.getAABB(i), 1.0f);
+            if (result.collided && (!hit || result.distance < toi)) {
+                hit = true;
+                toi = result.distance;
+                normal = result.normal;
+                brush = i;
+            }
+        }
+        return hit;
+    };
+    
+    // True if 'box' penetrates any candidate (touching is fine)
+    auto blocked = [&](const AABB& box) {
+        for (uint32_t i : nearbyBrushes) {
+            AABB brushBox = bounds.getAABB(i);
+            if (box.min.x < brushBox.max.x && box.max.x > brushBox.min.x &&
+                box.min.y < brushBox.max.y && box.max.y > brushBox.min.y &&
+                box.min.z < brushBox.max.z && box.max.z > brushBox.min.z) {
+                return true;
+            }
+        }
+        return false;
+    };
+    
+    // Depenetrate first: the sweep ignores overlaps deeper than its contact tolerance, so
+    // a player starting inside a brush (spawn point, leaving god mode, brushes changed at
+    // runtime) is pushed out along the axis of least overlap, one skin clear of the face
+    glm::vec3 offset(0.0f);
+    for (uint32_t i : nearbyBrushes) {
+        AABB box(startBox.min + offset, startBox.max + offset);
+        AABB brushBox = bounds.getAABB(i);
+        glm::vec3 overlap = glm::min(box.max, brushBox.max) - glm::max(box.min, brushBox.min);
+        if (overlap.x <= CollisionSystem::SWEEP_CONTACT_TOLERANCE ||
+            overlap.y <= CollisionSystem::SWEEP_CONTACT_TOLERANCE ||
+            overlap.z <= CollisionSystem::SWEEP_CONTACT_TOLERANCE) continue;
+        glm::vec3 push = CollisionSystem::resolveAABBCollision(box, brushBox);
+        offset += push + glm::sign(push) * COLLISION_SKIN;
+    }
+    if (offset != glm::vec3(0.0f)) {
+        // The push can carry the player out of the broadphase box
+        sweptBox = AABB(glm::min(sweptBox.min, sweptBox.min + offset), glm::max(sweptBox.max, sweptBox.max + offset));
+        map->getBrushGrid().query(sweptBox, nearbyBrushes);
+    }
     
-    // Handle movement for each axis separately
-    for (int axis = 0; axis < 3; ++axis) {
-        glm::vec3 axisMovement(0.0f);
-        axisMovement[axis] = movement[axis];
-        
-        if (std::abs(axisMovement[axis]) < 0.0001f) continue;
-        
-        // Create moved box
-        AABB movedBox = originalBox;
-        movedBox.min += axisMovement;
-        movedBox.max += axisMovement;
-        
-        bool collision = false;
+    glm::vec3 remaining = movement;
+    bool stepped = false;
+    
+    // Collide and slide: move to the first contact, drop the blocked component and
+    // continue with what is left. Normals are axis-aligned, so each contact plane
+    // removes one axis and the loop ends after at most three planes.
+    for (int plane = 0; plane < MAX_SLIDE_PLANES; ++plane) {
+        if (glm::dot(remaining, remaining) < 1e-12f) break;
+        
+        AABB box(startBox.min + offset, startBox.max + offset);
+        float toi;
+        glm::vec3 normal(0.0f);
+        uint32_t brush = 0;
+        if (!sweep(box, remaining, toi, normal, brush)) {
+            offset += remaining;
+            remaining = glm::vec3(0.0f);
+            break;
+        }
         
-        // Check collision with all brushes
-        for (const auto& brush : brushes) {
-            if (brush.vertices.empty()) continue;
-            
-            glm::vec3 brushMin = brush.vertices[0];
-            glm::vec3 brushMax = brush.vertices[0];
-            
-            for (const auto& vertex : brush.vertices) {
-                brushMin = glm::min(brushMin, vertex);
-                brushMax = glm::max(brushMax, vertex);
-            }
-            
-            AABB brushBox(brushMin, brushMax);
-            
-            if (CollisionSystem::checkAABB(movedBox, brushBox)) {
-                collision = true;
-                
-                // Try step climbing (only for non-Y axis and when on ground)
-                if (axis != 1 && onGround && brushBox.max.y - originalBox.min.y <= config.stepHeight) {
-                    // Try moving upward
-                    AABB stepBox = originalBox;
-                    stepBox.min.y = brushBox.max.y;
-                    stepBox.max.y = stepBox.min.y + config.height;
-                    stepBox.min += axisMovement;
-                    stepBox.max += axisMovement;
-                    
-                    // Check if there's still collision after stepping up
-                    bool canStep = true;
-                    for (const auto& otherBrush : brushes) {
-                        if (otherBrush.vertices.empty()) continue;
-                        
-                        glm::vec3 otherMin = otherBrush.vertices[0];
-                        glm::vec3 otherMax = otherBrush.vertices[0];
-                        
-                        for (const auto& vertex : otherBrush.vertices) {
-                            otherMin = glm::min(otherMin, vertex);
-                            otherMax = glm::max(otherMax, vertex);
-                        }
-                        
-                        AABB otherBox(otherMin, otherMax);
-                        if (CollisionSystem::checkAABB(stepBox, otherBox)) {
-                            canStep = false;
-                            break;
-                        }
-                    }
-                    
-                    if (canStep) {
-                        finalMovement.y = brushBox.max.y - originalBox.min.y + 0.01f;
-                        collision = false;
-                    }
+        // Step up onto a low ledge hit from the side while grounded: lift on top of it
+        // if the lift is clear and the rest of the move fits at the new height
+        if (!stepped && onGround && normal.y == 0.0f) {
+            float rise = bounds.maxY[brush] - box.min.y;
+            if (rise > 0.0f && rise <= config.stepHeight) {
+                glm::vec3 lift(0.0f, rise + COLLISION_SKIN, 0.0f);
+                glm::vec3 ahead(remaining.x, 0.0f, remaining.z);
+                AABB raised(box.min + lift + ahead, box.max + lift + ahead);
+                float liftToi;
+                glm::vec3 liftNormal(0.0f);
+                uint32_t liftBrush = 0;
+                if (!sweep(box, lift, liftToi, liftNormal, liftBrush) && !blocked(raised)) {
+                    offset += lift;
+                    stepped = true;
+                    --plane;  // The lift does not use up a slide plane
+                    continue;
                 }
-                
-                if (collision) break;
             }
         }
         
-        if (!collision) {
-            originalBox.min += axisMovement;
-            originalBox.max += axisMovement;
-        } else {
-            finalMovement[axis] = 0.0f;
-        }
+        // Advance to contact, stopping COLLISION_SKIN short of the surface
+        int axis = normal.x != 0.0f ? 0 : (normal.y != 0.0f ? 1 : 2);
+        float stop = std::max(0.0f, toi - COLLISION_SKIN / std::abs(remaining[axis]));
+        offset += remaining * stop;
+        remaining *= (1.0f - stop);
+        remaining[axis] = 0.0f;
     }
     
-    return finalMovement;
+    return offset;
 }
 
-glm::vec3 Player::getMovementInput(GLFWwindow* window, Camera* camera, float deltaTime) {
+glm::vec3 Player::getMovementInput(const PlayerInput& input, Camera* camera, float deltaTime) {
     (void)deltaTime; // Suppress unused parameter warning
     glm::vec3 movement(0.0f);
     
@@ -561,20 +528,20 @@ glm::vec3 Player::getMovementInput(GLFWwindow* window, Camera* camera, float del
     }
     
     // WASD movement
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+    if (input.forward)
         movement += forward;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+    if (input.back)
         movement -= forward;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+    if (input.left)
         movement -= right;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+    if (input.right)
         movement += right;
     
     // God mode: add vertical movement with Space/Shift
     if (isGodMode()) {
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
+        if (input.jump)
             movement += up;
-        if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+        if (input.sprint)
             movement -= up;
     }
     
@@ -1,14 +1,31 @@
 #include "player/weapon.h"
 #include "enemy/enemy_manager.h"
+#include "effects/particle_system.h"
+#include "engine/occupancy_grid.h"
+#include "engine/job_system.h"
+#include "engine/profiler.h"
+#include "engine/log.h"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
-#include <iostream>
 #include <algorithm>
 
 namespace silic2 {
 
+namespace {
+const glm::vec3 BULLET_COLOR(0.5f, 0.8f, 1.0f);  // Sky blue
+} // namespace
+
 Weapon::Weapon() : fireCooldown(0.0f), fireRate(0.06f), bulletVAO(0), bulletVBO(0), glowVAO(0), glowVBO(0), bulletLightingEnabled(false) {
+    impactParticles = std::make_unique<ParticleSystem>(256, ParticleStream::IMPACTS);
+    impactParticles->setCollisionResponse(ParticleCollision::BOUNCE);   // Sparks skip off walls and floors
+    
+    // Size the per-bullet scratch for a full pool so update() never allocates
+    bulletSegments.reserve(bullets.capacity());
+    segmentBullets.reserve(bullets.capacity());
+    enemyHits.reserve(bullets.capacity());
+    bulletSpent.reserve(bullets.capacity());
+    bulletWallHits.reserve(bullets.capacity());
 }
 
 Weapon::~Weapon() {
@@ -32,7 +49,7 @@ void Weapon::init() {
         bulletShader = std::make_unique<Shader>("res/shaders/bullet.vert", "res/shaders/bullet.frag");
         glowShader = std::make_unique<Shader>("res/shaders/glow.vert", "res/shaders/glow.frag");
     } catch (const std::exception& e) {
-        std::cerr << "Failed to load shaders: " << e.what() << std::endl;
+        SILIC2_LOG_ERROR("Failed to load shaders: " << e.what());
         throw;
     }
     
@@ -141,34 +158,55 @@ void Weapon::setupGlowMesh() {
 }
 
 void Weapon::update(float deltaTime, const Map* map, EnemyManager* enemies) {
+    SILIC2_PROFILE_ZONE("Weapon::update");
     // Update fire cooldown
     if (fireCooldown > 0.0f) {
         fireCooldown -= deltaTime;
     }
     
-    // Update all bullets and check collisions
-    for (auto it = bullets.begin(); it != bullets.end(); ) {
-        it->update(deltaTime);
-        
-        // Check collision with map walls
-        bool hitWall = map && checkBulletCollision(*it, map);
-        if (hitWall && bulletLightingEnabled) {
-            createImpactLight(it->position, it->color, it->intensity);
+    resolveHitscanShots(map, enemies);
+    
+    // Advance all bullets and test them against the map walls in parallel jobs
+    bulletWallHits.assign(bullets.size(), SegmentHit());
+    JobSystem::getInstance().parallelFor(bullets.size(), BULLET_JOB_GRAIN, [&](size_t begin, size_t end) {
+        bullets.integrate(begin, end, deltaTime);
+        for (size_t i = begin; i < end; ++i) {
+            checkBulletCollision(i, map, bulletWallHits[i]);
         }
-
-        // Check collision with enemies using swept segment (prevents tunneling)
-        bool hitEnemy = false;
-        if (!hitWall && enemies && it->lifetime > 0.02f) {
-            hitEnemy = enemies->checkBulletHit(it->prevPosition, it->position, 1);
+    });
+    
+    // Impact lights and the enemy batch are built in bullet order
+    bulletSegments.clear();
+    segmentBullets.clear();
+    bulletSpent.assign(bullets.size(), 0);
+    for (size_t i = 0; i < bullets.size(); ++i) {
+        const SegmentHit& wallHit = bulletWallHits[i];
+        if (wallHit.hit) {
+            bulletSpent[i] = 1;
+            if (bulletLightingEnabled) {
+                // Place the flash just in front of the surface that was hit
+                createImpactLight(wallHit.point + wallHit.normal * 0.05f, BULLET_COLOR, BULLET_INTENSITY);
+            }
+        } else if (bullets.getLifetime(i) > 0.02f) {
+            // Swept segment for the enemy pass (prevents tunneling)
+            bulletSegments.push(bullets.getPrevPosition(i), bullets.getPosition(i));
+            segmentBullets.push_back(static_cast<uint32_t>(i));
         }
-
-        if (hitWall || hitEnemy) {
-            it = bullets.erase(it);
-        } else if (!it->isAlive()) {
-            // Bullet timeout
-            it = bullets.erase(it);
-        } else {
-            ++it;
+    }
+    
+    // Resolve every remaining bullet against the enemies in one batch
+    if (enemies && bulletSegments.size() > 0) {
+        enemies->checkBulletHits(bulletSegments, 1, enemyHits);
+        for (size_t s = 0; s < segmentBullets.size(); ++s) {
+            if (enemyHits[s]) bulletSpent[segmentBullets[s]] = 1;
+        }
+    }
+    
+    // Remove bullets that hit something or timed out. Walking backwards, the bullet
+    // swapped into slot i has already been checked.
+    for (size_t i = bullets.size(); i-- > 0;) {
+        if (bulletSpent[i] || bullets.getLifetime(i) >= BULLET_LIFETIME) {
+            bullets.remove(i);
         }
     }
     
@@ -176,19 +214,14 @@ void Weapon::update(float deltaTime, const Map* map, EnemyManager* enemies) {
     for (auto& light : impactLights) {
         light.update(deltaTime);
     }
+    // The map can change between ticks, so the grid is picked up every update
+    impactParticles->setCollisionGrid(map ? &map->getOccupancyGrid() : nullptr);
+    impactParticles->update(deltaTime);
     
     // Clean up dead lights
     cleanupDeadLights();
 }
 
-void Weapon::cleanupDeadBullets() {
-    bullets.erase(
-        std::remove_if(bullets.begin(), bullets.end(),
-            [](const Bullet& b) { return !b.isAlive(); }),
-        bullets.end()
-    );
-}
-
 void Weapon::cleanupDeadLights() {
     impactLights.erase(
         std::remove_if(impactLights.begin(), impactLights.end(),
@@ -197,47 +230,68 @@ void Weapon::cleanupDeadLights() {
     );
 }
 
-// Segment-AABB slab test (t in [0,1])
-static bool segmentHitsAABB(const glm::vec3& start, const glm::vec3& end,
-                             const glm::vec3& bMin, const glm::vec3& bMax) {
-    glm::vec3 d = end - start;
-    float tMin = 0.0f, tMax = 1.0f;
-    for (int i = 0; i < 3; ++i) {
-        if (std::abs(d[i]) < 1e-8f) {
-            if (start[i] < bMin[i] || start[i] > bMax[i]) return false;
-        } else {
-            float t1 = (bMin[i] - start[i]) / d[i];
-            float t2 = (bMax[i] - start[i]) / d[i];
-            if (t1 > t2) std::swap(t1, t2);
-            tMin = std::max(tMin, t1);
-            tMax = std::min(tMax, t2);
-            if (tMin > tMax) return false;
+bool Weapon::checkBulletCollision(size_t bullet, const Map* map, SegmentHit& hit) const {
+    if (!map || bullets.getLifetime(bullet) <= 0.02f) return false;
+
+    hit = map->getBrushBVH().intersectSegment(bullets.getPrevPosition(bullet), bullets.getPosition(bullet));
+    return hit.hit;
+}
+
+void Weapon::resolveHitscanShots(const Map* map, EnemyManager* enemies) {
+    if (pendingShots.empty()) return;
+    
+    // Clip every ray at the first wall (BVH), then let the enemies claim the nearer hits in one batch
+    bulletSegments.clear();
+    shotWallHits.resize(pendingShots.size());
+    for (size_t s = 0; s < pendingShots.size(); ++s) {
+        const HitscanShot& shot = pendingShots[s];
+        glm::vec3 end = shot.origin + shot.direction * HITSCAN_RANGE;
+        shotWallHits[s] = map ? map->getBrushBVH().intersectSegment(shot.origin, end) : SegmentHit();
+        bulletSegments.push(shot.origin, shotWallHits[s].hit ? shotWallHits[s].point : end);
+    }
+    
+    if (enemies) {
+        enemies->checkBulletHits(bulletSegments, 1, enemyHits, &shotEnemyT);
+    } else {
+        enemyHits.assign(pendingShots.size(), 0);
+    }
+    
+    for (size_t s = 0; s < pendingShots.size(); ++s) {
+        if (enemyHits[s]) {
+            glm::vec3 start(bulletSegments.startX[s], bulletSegments.startY[s], bulletSegments.startZ[s]);
+            glm::vec3 end(bulletSegments.endX[s], bulletSegments.endY[s], bulletSegments.endZ[s]);
+            spawnImpact(start + (end - start) * shotEnemyT[s], -pendingShots[s].direction);
+        } else if (shotWallHits[s].hit) {
+            spawnImpact(shotWallHits[s].point, shotWallHits[s].normal);
         }
     }
-    return true;
+    pendingShots.clear();
 }
 
-bool Weapon::checkBulletCollision(const Bullet& bullet, const Map* map) {
-    if (!map || bullet.lifetime <= 0.02f) return false;
+void Weapon::spawnImpact(const glm::vec3& point, const glm::vec3& normal) {
+    // Offset off the surface so the flash and sparks are not buried in it
+    glm::vec3 origin = point + normal * 0.05f;
+    if (bulletLightingEnabled) {
+        createImpactLight(origin, BULLET_COLOR, BULLET_INTENSITY);
+    }
 
-    for (const auto& brush : map->getBrushes()) {
-        if (brush.vertices.empty()) continue;
-        glm::vec3 bMin = brush.vertices[0], bMax = brush.vertices[0];
-        for (const auto& v : brush.vertices) {
-            bMin = glm::min(bMin, v);
-            bMax = glm::max(bMax, v);
-        }
-        if (segmentHitsAABB(bullet.prevPosition, bullet.position, bMin, bMax)) {
-            return true;
+    // Particles skip collision while they start in a solid cell, and the wall's cell is
+    // wider than the offset above, so step the sparks out of it or they would not bounce
+    glm::vec3 sparkOrigin = origin;
+    const OccupancyGrid* grid = impactParticles->getCollisionGrid();
+    if (grid && !grid->empty()) {
+        for (int step = 0; step < IMPACT_MAX_CELL_STEPS && grid->isSolid(sparkOrigin); ++step) {
+            sparkOrigin += normal * grid->getCellSize();
         }
     }
-    return false;
+    impactParticles->emitBurst(sparkOrigin, IMPACT_PARTICLE_COUNT, normal * 2.0f, glm::vec3(1.5f),
+                               BULLET_COLOR, 0.3f, 3.0f, 1.0f);
 }
 
 void Weapon::createImpactLight(const glm::vec3& position, const glm::vec3& color, float intensity) {
     impactLights.emplace_back(position, color, intensity);
-    std::cout << "Created impact light at: " << position.x << ", " << position.y << ", " << position.z 
-              << " | Total impact lights: " << impactLights.size() << std::endl;
+    SILIC2_LOG_DEBUG("Created impact light at: " << position.x << ", " << position.y << ", " << position.z 
+              << " | Total impact lights: " << impactLights.size());
 }
 
 void Weapon::fire(const Camera& camera) {
@@ -251,6 +305,12 @@ void Weapon::fire(const Camera& camera) {
     glm::vec3 cameraRight = camera.getRight();
     glm::vec3 cameraUp = camera.getUp();
     
+    if (fireMode == FireMode::HITSCAN) {
+        pendingShots.push_back({cameraPos, cameraFront});
+        fireCooldown = fireRate;
+        return;
+    }
+    
     // Calculate bullet start position (slight visual offset from gun)
     glm::vec3 bulletStartPos = cameraPos;
     bulletStartPos += cameraFront * 0.3f;
@@ -262,14 +322,16 @@ void Weapon::fire(const Camera& camera) {
     glm::vec3 aimPoint = cameraPos + cameraFront * 100.0f;
     glm::vec3 bulletDirection = glm::normalize(aimPoint - bulletStartPos);
     
-    // Create new bullet
-    bullets.emplace_back(bulletStartPos, bulletDirection, 65.0f);
+    // Create new bullet (dropped if the pool is full)
+    bullets.spawn(bulletStartPos, bulletDirection * BULLET_SPEED);
     
     // Reset cooldown time
     fireCooldown = fireRate;
 }
 
-void Weapon::render(const glm::mat4& view, const glm::mat4& projection) {
+void Weapon::render(const glm::mat4& view, const glm::mat4& projection, float alpha) {
+    impactParticles->render(view, projection);
+    
     if (bullets.empty()) {
         return;
     }
@@ -286,9 +348,9 @@ void Weapon::render(const glm::mat4& view, const glm::mat4& projection) {
     glBindVertexArray(glowVAO);
     
     // Render glow for each bullet
-    for (const auto& bullet : bullets) {
+    for (size_t i = 0; i < bullets.size(); ++i) {
         glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, bullet.position);
+        model = glm::translate(model, glm::mix(bullets.getPrevPosition(i), bullets.getPosition(i), alpha));
         
         // Billboard effect - always face camera
         glm::vec3 cameraRight = glm::vec3(view[0][0], view[1][0], view[2][0]);
@@ -299,8 +361,8 @@ void Weapon::render(const glm::mat4& view, const glm::mat4& projection) {
         model[2] = glm::vec4(0.0f, 0.0f, 0.8f, 0.0f);
         
         glowShader->setMat4("model", model);
-        glowShader->setVec3("glowColor", bullet.color);
-        glowShader->setFloat("intensity", bullet.intensity * 0.5f);
+        glowShader->setVec3("glowColor", BULLET_COLOR);
+        glowShader->setFloat("intensity", BULLET_INTENSITY * 0.5f);
         
         glDrawArrays(GL_TRIANGLES, 0, 6);
     }
@@ -319,13 +381,13 @@ void Weapon::render(const glm::mat4& view, const glm::mat4& projection) {
     glBindVertexArray(bulletVAO);
     
     // Render each bullet
-    for (const auto& bullet : bullets) {
+    for (size_t i = 0; i < bullets.size(); ++i) {
         // Calculate bullet model matrix
         glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, bullet.position);
+        model = glm::translate(model, glm::mix(bullets.getPrevPosition(i), bullets.getPosition(i), alpha));
         
         // Rotate according to bullet direction
-        glm::vec3 forward = bullet.direction;
+        glm::vec3 forward = glm::normalize(bullets.getVelocity(i));
         glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
         if (glm::abs(glm::dot(forward, up)) > 0.99f) {
             up = glm::vec3(1.0f, 0.0f, 0.0f);
@@ -342,8 +404,8 @@ void Weapon::render(const glm::mat4& view, const glm::mat4& projection) {
         
         // Set shader parameters
         bulletShader->setMat4("model", model);
-        bulletShader->setVec3("bulletColor", bullet.color);
-        bulletShader->setFloat("intensity", bullet.intensity);
+        bulletShader->setVec3("bulletColor", BULLET_COLOR);
+        bulletShader->setFloat("intensity", BULLET_INTENSITY);
         
         // Draw bullet
         glDrawArrays(GL_TRIANGLES, 0, 36);
@@ -352,17 +414,16 @@ void Weapon::render(const glm::mat4& view, const glm::mat4& projection) {
     glBindVertexArray(0);
 }
 
-std::vector<std::pair<glm::vec3, glm::vec3>> Weapon::getActiveLights() const {
-    std::vector<std::pair<glm::vec3, glm::vec3>> lights;
-    
+FrameVector<std::pair<glm::vec3, glm::vec3>> Weapon::getActiveLights(FrameArena& arena) const {
     // If bullet lighting is disabled, just return empty list (but bullet glows still show)
     if (!bulletLightingEnabled) {
-        return lights;
+        return makeFrameVector<std::pair<glm::vec3, glm::vec3>>(arena);
     }
+    auto lights = makeFrameVector<std::pair<glm::vec3, glm::vec3>>(arena, bullets.size() + impactLights.size());
     
     // Add bullet light sources
-    for (const auto& bullet : bullets) {
-        lights.emplace_back(bullet.getLightPosition(), bullet.getLightColor());
+    for (size_t i = 0; i < bullets.size(); ++i) {
+        lights.emplace_back(bullets.getPosition(i), BULLET_COLOR * BULLET_INTENSITY);
     }
     
     // Add impact lights
@@ -371,8 +432,7 @@ std::vector<std::pair<glm::vec3, glm::vec3>> Weapon::getActiveLights() const {
         glm::vec3 fadedColor = impact.color * impact.getFadedIntensity();
         lights.emplace_back(impact.position, fadedColor);
     }
-    
     return lights;
 }
 
-} // namespace silic2
\ No newline at end of file
+} // namespace silic2